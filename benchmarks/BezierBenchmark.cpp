@@ -0,0 +1,57 @@
+/**
+ * @file BezierBenchmark.cpp
+ * @brief Bezier evaluation time per degree
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-02-13
+ */
+#include <Eigen/Core>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "src/main/math/Bezier.h"
+
+using namespace iphito::math;
+
+static std::vector<Eigen::Vector2d> controlPoints(int degree) {
+
+  std::vector<Eigen::Vector2d> points;
+  for (int i = 0; i <= degree; i++) {
+    points.push_back(Eigen::Vector2d(std::cos(i * 0.1), std::sin(i * 0.37)));
+  }
+
+  return points;
+}
+
+TEST_CASE("Bezier evaluation time per degree", "[Bezier][benchmark]") {
+
+  const int samples = 1024;
+  std::vector<double> t(samples);
+  for (int i = 0; i < samples; i++) {
+    t[i] = i / (samples - 1.0);
+  }
+  std::vector<Eigen::Vector2d> points(samples);
+
+  for (int degree : {3, 8, 20, 50, 100, 200, 500, 1000, 2000}) {
+
+    Bezier b(controlPoints(degree));
+
+    BENCHMARK("evaluateAt(double), degree " + std::to_string(degree) + ", " +
+              std::to_string(samples) + " points") {
+      Eigen::Vector2d sum = Eigen::Vector2d::Zero();
+      for (double ti : t) {
+        sum += b.evaluateAt(ti);
+      }
+      return sum;
+    };
+
+    BENCHMARK("evaluateAt(span), degree " + std::to_string(degree) + ", " +
+              std::to_string(samples) + " points") {
+      b.evaluateAt(t, points);
+      return points[samples / 2];
+    };
+  }
+}
@@ -2,29 +2,31 @@ set(UTILS_DIR ./utils/)
 
 set(UTILS_SRC
     Logger.cpp
+    ThreadPool.cpp
     Utils.cpp
     )
 
 set(UTILS_H
     Logger.h
+    ThreadPool.h
     Utils.h
     )
 
 set(MATH_DIR ./math/)
 
 set(MATH_SRC
-    Hermite3.cpp
-    Hermite5.cpp
     Bezier.cpp
     Line.cpp
     )
 
 set(MATH_H
     Curve.h
+    Hermite.h
     Hermite3.h
     Hermite5.h
     Bezier.h
     Line.h
+    Simd.h
     )
 
 set(RENDERER_DIR ./renderer/)
@@ -46,6 +48,22 @@ set(RENDERER_SRC
     Curve2DFactory.cpp
     Grid.cpp
     AABB.cpp
+    MidpointSampler.cpp
+    CurvatureSampler.cpp
+    WangFlattener.cpp
+    LevelOfDetail.cpp
+    CurveClipper.cpp
+    ShaderRegistry.cpp
+    ShaderSources.cpp
+    CameraUniformBuffer.cpp
+    StrokeBatch.cpp
+    StrokeStorage.cpp
+    StreamBuffer.cpp
+    FrameScheduler.cpp
+    BoundingVolumeHierarchy.cpp
+    SceneIndex.cpp
+    InstancedOverlay.cpp
+    RangeAllocator.cpp
     )
 
 set(RENDERER_H
@@ -65,6 +83,23 @@ set(RENDERER_H
     Curve2DFactory.h
     Grid.h
     AABB.h
+    Sampler.h
+    MidpointSampler.h
+    CurvatureSampler.h
+    WangFlattener.h
+    LevelOfDetail.h
+    CurveClipper.h
+    ShaderRegistry.h
+    ShaderSources.h
+    CameraUniformBuffer.h
+    StrokeBatch.h
+    StrokeStorage.h
+    StreamBuffer.h
+    FrameScheduler.h
+    BoundingVolumeHierarchy.h
+    SceneIndex.h
+    InstancedOverlay.h
+    RangeAllocator.h
     )
 
 set(CLI_DIR ./cli/)
@@ -1,3 +1,4 @@
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -21,6 +22,7 @@
 #include "src/main/renderer/Hermite52D.h"
 #include "src/main/renderer/Layer.h"
 #include "src/main/renderer/Shader.h"
+#include "src/main/renderer/ShaderRegistry.h"
 #include "src/main/renderer/Window.h"
 #include "src/main/utils/Logger.h"
 #include "src/main/utils/Utils.h"
@@ -33,19 +35,28 @@ using namespace iphito::utils;
 static constexpr auto USAGE =
 R"(
 Usage:
-    iphito show <curve_definition>
-    iphito (-f | --file ) <curve_definition_file_path>
+    iphito show [--tolerance=<px>] [--shader-cache=<dir>] [--continuous]
+           <curve_definition>
+    iphito [--tolerance=<px>] [--shader-cache=<dir>] [--continuous]
+           (-f | --file ) <curve_definition_file_path>
     iphito (-e | --export) <curve_definition>
     iphito (-v | --version)
     iphito (-h | --help)
 Options:
-    -f --file       Use file with curve definition
-    -e --export     Export curves in ps format.
-    -v --version    Show version.
-    -h --help       Show this screen.
+    -f --file             Use file with curve definition
+    -e --export           Export curves in ps format.
+    -t --tolerance=<px>   Maximal distance in pixels between a curve and its
+                          tessellation [default: 0.25].
+    --shader-cache=<dir>  Directory caching the linked shader programs
+                          between runs.
+    --continuous          Draw frames continuously instead of on demand and
+                          log the frame times.
+    -v --version          Show version.
+    -h --help             Show this screen.
 )";
 
-void renderCurves(const std::string& curves) {
+void renderCurves(const std::string& curves, double tolerance,
+                  bool isContinuous) {
     int WIDTH = 640;
     int HEIGHT = 640;
 
@@ -56,7 +67,13 @@ void renderCurves(const std::string& curves) {
 
     try{
         Window w(WIDTH, HEIGHT, "iphito");
-        std::unique_ptr<Canvas> canvas(new Canvas(WIDTH, HEIGHT));
+
+        /* The canvas measures its tolerance in pixels of the framebuffer. */
+        int framebufferWidth = 0;
+        int framebufferHeight = 0;
+        w.getFramebufferSize(framebufferWidth, framebufferHeight);
+        std::unique_ptr<Canvas> canvas(new Canvas(framebufferWidth,
+                                                  framebufferHeight));
 
         std::shared_ptr<ASTNode> rootNode = parser.getRootNode();
         Curve2DFactory curve2DFactory(rootNode);
@@ -72,11 +89,13 @@ void renderCurves(const std::string& curves) {
         curve2DFactory.setControlPointsColor(controlPointsColor);
         curve2DFactory.setSecondDerivativeColor(secondDerivativeColor);
         curve2DFactory.setCurveWidth(curveWidth);
+        curve2DFactory.setTolerance(tolerance);
 
         std::unique_ptr<Layer> rootLayer = curve2DFactory.getRootLayer();
 
         canvas->setRootLayer(std::move(rootLayer));
         w.setCanvas(canvas);
+        w.setContinuousRendering(isContinuous);
         w.render();
     }
     catch(std::exception& e) {
@@ -94,9 +113,28 @@ int main(int argc, char *argv[])
             true,
             "1.0.0");
 
+    double tolerance = Curve2D::defaultTolerance;
+    try {
+        tolerance = std::stod(args["--tolerance"].asString());
+
+        /* std::stod reads "nan" and "inf" too. */
+        if (!(tolerance > 0.0) || !std::isfinite(tolerance))
+            throw std::domain_error("non positive tolerance");
+    }
+    catch(std::exception& e) {
+        Logger::Instance()->critical("the tolerance has to be a positive "
+                                     "number");
+        return 1;
+    }
+
+    if (args["--shader-cache"]) {
+        ShaderRegistry::Instance()->setBinaryCacheDirectory(
+                args["--shader-cache"].asString());
+    }
+
     if (args["show"].asBool()) {
         auto curve = args["<curve_definition>"].asString();
-        renderCurves(curve);
+        renderCurves(curve, tolerance, args["--continuous"].asBool());
     }
     else if (args["--file"].asBool()) {
         // TODO: requirements macOS >= 10.15
@@ -106,7 +144,8 @@ int main(int argc, char *argv[])
             auto fileName = args["<curve_definition_file_path>"].asString();
             std::ifstream inputStream(fileName);
             std::string fileContent(std::istreambuf_iterator<char>{inputStream}, {});
-            renderCurves(fileContent);
+            renderCurves(fileContent, tolerance,
+                         args["--continuous"].asBool());
         /* } */
         /* else { */
         /*     Logger::Instance()->critical("input file does not exist!"); */
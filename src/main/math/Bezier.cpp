@@ -5,32 +5,36 @@
  * @version 1.0
  * @date 2018-10-16
  */
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 #include "Bezier.h"
 #include "Line.h"
+#include "Simd.h"
 #include "src/main/utils/Utils.h"
 
 namespace iphito::math {
 
 using namespace iphito::utils;
 
-Bezier::Bezier(std::vector<Eigen::Vector2d> points) : degree{0} {
+Bezier::Bezier(std::vector<Eigen::Vector2d> points) :
+    curve{static_cast<int>(points.size()) - 1},
+    velocity{static_cast<int>(points.size()) - 2},
+    acceleration{static_cast<int>(points.size()) - 3} {
 
     if(points.size() <= 1) {
         throw std::length_error("A Bézier curve has to have at least two"
                                 "points.");
     }
 
-    this->degree = points.size() - 1;
-
     for (int i = 0; i < points.size(); i++) {
-        double bernsteinCoefficient = Utils::factorial(this->degree) /
-                                      (Utils::factorial(i) *
-                                       Utils::factorial(this->degree - i));
-
-        this->pointsAndBernstein[i] = {points[i], bernsteinCoefficient};
+        this->curve.x[i] = points[i][0];
+        this->curve.y[i] = points[i][1];
     }
+
+    this->curve.recomputeWeightedPoints();
+    this->recomputeDerivatives();
 }
 
 Bezier::~Bezier() {}
@@ -38,18 +42,50 @@ Bezier::~Bezier() {}
 
 Eigen::Vector2d Bezier::evaluateAt(double t) {
 
-    Eigen::Vector2d sum(0.0, 0.0);
+    return this->curve.evaluateAt(t);
+}
+
+void Bezier::evaluateAt(std::span<const double> t,
+                        std::span<Eigen::Vector2d> points) {
+
+    if (points.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
+    }
+
+    this->curve.evaluateAt(t, points);
+}
+
+Eigen::Vector2d Bezier::derivativeAt(double t) {
+
+    return this->velocity.evaluateAt(t);
+}
+
+void Bezier::derivativeAt(std::span<const double> t,
+                          std::span<Eigen::Vector2d> derivatives) {
+
+    if (derivatives.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
+    }
+
+    this->velocity.evaluateAt(t, derivatives);
+}
+
+Eigen::Vector2d Bezier::secondDerivativeAt(double t) {
+
+    return this->acceleration.evaluateAt(t);
+}
 
-    for (auto& i : this->pointsAndBernstein) {
-        int power = i.first;
-        double bernstein = i.second.second;
-        Eigen::Vector2d point = i.second.first;
+void Bezier::secondDerivativeAt(std::span<const double> t,
+                                std::span<Eigen::Vector2d> derivatives) {
 
-        sum += bernstein * pow(t, power) * pow(1-t, this->degree - power) *
-               point;
+    if (derivatives.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
     }
 
-    return sum;
+    this->acceleration.evaluateAt(t, derivatives);
 }
 
 std::unique_ptr<Curve> Bezier::offsetBy(double amount) {
@@ -104,30 +140,337 @@ std::unique_ptr<Curve> Bezier::offsetBy(double amount) {
 
 void Bezier::setPoints(std::vector<Eigen::Vector2d>& points) {
 
-    if(points.size() != this->degree + 1) {
+    if(points.size() != this->curve.x.size()) {
         throw std::length_error("The points count has to be the same as the"
                                 "current count of the curve.");
     }
     
-    for (int i = 0; i < points.size(); i++)
-        this->pointsAndBernstein[i].first = points[i];
+    for (int i = 0; i < points.size(); i++) {
+        this->curve.x[i] = points[i][0];
+        this->curve.y[i] = points[i][1];
+    }
 
+    this->curve.recomputeWeightedPoints();
+    this->recomputeDerivatives();
 }
 
 std::vector<Eigen::Vector2d> Bezier::getPoints() {
 
     std::vector<Eigen::Vector2d> controlPoints;
+    const int size = this->curve.x.size();
+    controlPoints.reserve(size);
     
-    for (auto& i : this->pointsAndBernstein)
-        controlPoints.push_back(i.second.first);
+    for (int i = 0; i < size; i++)
+        controlPoints.emplace_back(this->curve.x[i], this->curve.y[i]);
 
     return controlPoints;
 }
 
+std::vector<Eigen::Vector2d> Bezier::getBezierPoints() {
+
+    return this->getPoints();
+}
+
 std::map<int, std::pair<Eigen::Vector2d, double>>
 Bezier::getPointsAndBernstein() {
 
-    return this->pointsAndBernstein;
+    std::map<int, std::pair<Eigen::Vector2d, double>> pointsAndBernstein;
+
+    /* Only the curves evaluated with nested multiplication keep a table. */
+    const bool isTabulated = this->curve.degree <= Bezier::maximumNestedDegree;
+    const int size = this->curve.x.size();
+
+    for (int i = 0; i < size; i++) {
+        pointsAndBernstein[i] = {
+            Eigen::Vector2d(this->curve.x[i], this->curve.y[i]),
+            isTabulated ? this->curve.binomial[i] :
+                          Utils::binomial(this->curve.degree, i)};
+    }
+
+    return pointsAndBernstein;
+}
+
+/**
+ * Splits the Bézier curve of the given control points at t with de
+ * Casteljau's algorithm.
+ *
+ * @return the control points of the curve restricted to [0, t] and [t, 1],
+ * both reparametrized over [0, 1].
+ */
+std::pair<std::vector<Eigen::Vector2d>, std::vector<Eigen::Vector2d>>
+Bezier::subdivide(const std::vector<Eigen::Vector2d>& points, double t) {
+
+    const int n = points.size();
+    std::vector<Eigen::Vector2d> left(n);
+    std::vector<Eigen::Vector2d> right(n);
+    std::vector<Eigen::Vector2d> q = points;
+
+    for (int k = 0; k < n; k++) {
+        left[k] = q[0];
+        right[n - 1 - k] = q[n - 1 - k];
+
+        for (int i = 0; i < n - 1 - k; i++)
+            q[i] = (1.0 - t) * q[i] + t * q[i+1];
+    }
+
+    return {left, right};
+}
+
+/**
+ * Exact axis aligned bounds (min, max) of the Bézier curve with the given
+ * control points. The curve lies in the box of its control points, and only
+ * leaves the box of its end points along an axis at the roots of the
+ * derivative of that coordinate, which are isolated in the Bernstein basis.
+ */
+std::pair<Eigen::Vector2d, Eigen::Vector2d>
+Bezier::bounds(const std::vector<Eigen::Vector2d>& points) {
+
+    if (points.empty())
+        throw std::length_error("A Bézier curve has to have points.");
+
+    Eigen::Vector2d min = points.front().cwiseMin(points.back());
+    Eigen::Vector2d max = points.front().cwiseMax(points.back());
+
+    for (int axis = 0; axis < 2; axis++) {
+
+        bool isInside = std::all_of(points.begin(), points.end(),
+                [&](const Eigen::Vector2d& p) {
+                    return min[axis] <= p[axis] && p[axis] <= max[axis];
+                });
+        if (isInside) continue;
+
+        const int size = points.size() - 1;
+        std::vector<double> derivative(size);
+        for (int i = 0; i < size; i++)
+            derivative[i] = points[i+1][axis] - points[i][axis];
+
+        std::vector<double> roots;
+        Bezier::isolateRoots(derivative, 0.0, 1.0, 0, roots);
+
+        for (double t : roots) {
+            Eigen::Vector2d p = Bezier::subdivide(points, t).first.back();
+            min = min.cwiseMin(p);
+            max = max.cwiseMax(p);
+        }
+    }
+
+    return {min, max};
+}
+
+/**
+ * Appends the roots in [a, b] of the scalar polynomial with the given
+ * Bernstein coefficients over [a, b]. It has no more roots than its
+ * coefficients have sign changes, and exactly one when they change sign once
+ * between nonzero end values, which is then found by bisection. Otherwise the
+ * interval is split in halves.
+ */
+void Bezier::isolateRoots(const std::vector<double>& coefficients, double a,
+                          double b, int depth, std::vector<double>& roots) {
+
+    int signChanges = 0;
+    double previous = 0.0;
+
+    for (double c : coefficients) {
+        if (c == 0.0) continue;
+        if (previous != 0.0 && (c > 0.0) != (previous > 0.0)) signChanges++;
+        previous = c;
+    }
+
+    if (signChanges == 0) return;
+
+    if (signChanges == 1 &&
+        coefficients.front() * coefficients.back() < 0.0) {
+
+        double low = 0.0;
+        double high = 1.0;
+        bool isLowNegative = coefficients.front() < 0.0;
+
+        for (int i = 0; i < Bezier::bisectionSteps; i++) {
+            double middle = 0.5 * (low + high);
+            bool isNegative = Bezier::evaluateScalar(coefficients, middle) <
+                              0.0;
+            if (isNegative == isLowNegative) low = middle;
+            else high = middle;
+        }
+
+        roots.push_back(a + 0.5 * (low + high) * (b - a));
+        return;
+    }
+
+    if (depth == Bezier::maximumRootDepth) {
+        roots.push_back(0.5 * (a + b));
+        return;
+    }
+
+    /* de Casteljau at 1/2 on the coefficients. */
+    const int n = coefficients.size();
+    std::vector<double> left(n);
+    std::vector<double> right(n);
+    std::vector<double> q = coefficients;
+
+    for (int k = 0; k < n; k++) {
+        left[k] = q[0];
+        right[n - 1 - k] = q[n - 1 - k];
+
+        for (int i = 0; i < n - 1 - k; i++)
+            q[i] = 0.5 * (q[i] + q[i+1]);
+    }
+
+    double middle = 0.5 * (a + b);
+    Bezier::isolateRoots(left, a, middle, depth + 1, roots);
+    Bezier::isolateRoots(right, middle, b, depth + 1, roots);
+}
+
+double Bezier::evaluateScalar(std::vector<double> coefficients, double t) {
+
+    for (int k = coefficients.size() - 1; k > 0; k--) {
+        for (int i = 0; i < k; i++)
+            coefficients[i] = (1.0 - t) * coefficients[i] +
+                              t * coefficients[i+1];
+    }
+
+    return coefficients[0];
+}
+
+/**
+ * Rebuilds the hodographs: the derivative of a Bézier curve of degree n is the
+ * Bézier curve of degree n - 1 with control points n (P_{i+1} - P_i).
+ */
+void Bezier::recomputeDerivatives() {
+
+    this->velocity.differentiate(this->curve);
+    this->acceleration.differentiate(this->velocity);
+}
+
+/**
+ * A negative degree stands for the zero polynomial, the derivative of a
+ * constant.
+ *
+ * The binomial coefficients are only tabulated up to maximumNestedDegree, and
+ * their logarithms above it, where the coefficients themselves overflow. Both
+ * tables are filled in O(n) from C(n, i + 1) = C(n, i) (n - i) / (i + 1), and
+ * mirrored since C(n, n - i) = C(n, i).
+ */
+Bezier::Polynomial::Polynomial(int degree) : degree{degree} {
+
+    if (degree < 0) return;
+
+    this->x.resize(degree + 1);
+    this->y.resize(degree + 1);
+
+    if (degree <= Bezier::maximumNestedDegree) {
+        this->binomial.resize(degree + 1);
+        this->binomial[0] = this->binomial[degree] = 1.0;
+
+        for (int i = 0; i < degree / 2; i++) {
+            this->binomial[i+1] = this->binomial[degree-i-1] = std::round(
+                    this->binomial[i] * (degree - i) / (i + 1));
+        }
+    }
+    else {
+        this->logBinomial.resize(degree + 1);
+        this->logBinomial[0] = this->logBinomial[degree] = 0.0;
+
+        for (int i = 0; i < degree / 2; i++) {
+            this->logBinomial[i+1] = this->logBinomial[degree-i-1] =
+                this->logBinomial[i] + std::log(degree - i) - std::log(i + 1);
+        }
+    }
+}
+
+void Bezier::Polynomial::recomputeWeightedPoints() {
+
+    if (this->degree > Bezier::maximumNestedDegree) return;
+
+    this->weightedX.resize(this->x.size());
+    this->weightedY.resize(this->y.size());
+
+    const int size = this->x.size();
+
+    for (int i = 0; i < size; i++) {
+        this->weightedX[i] = this->binomial[i] * this->x[i];
+        this->weightedY[i] = this->binomial[i] * this->y[i];
+    }
+}
+
+void Bezier::Polynomial::differentiate(const Polynomial& polynomial) {
+
+    const int n = polynomial.degree;
+
+    for (int i = 0; i <= this->degree; i++) {
+        this->x[i] = n * (polynomial.x[i+1] - polynomial.x[i]);
+        this->y[i] = n * (polynomial.y[i+1] - polynomial.y[i]);
+    }
+
+    this->recomputeWeightedPoints();
+}
+
+Eigen::Vector2d Bezier::Polynomial::evaluateAt(double t) const {
+
+    if (this->degree < 0) return Eigen::Vector2d::Zero();
+    if (this->degree == 0) return Eigen::Vector2d(this->x[0], this->y[0]);
+
+    if (this->degree > Bezier::maximumNestedDegree)
+        return this->evaluateHighDegree(t);
+
+    return simd::evaluateBernstein(this->weightedX.data(),
+                                   this->weightedY.data(), this->degree + 1, t);
+}
+
+void Bezier::Polynomial::evaluateAt(std::span<const double> t,
+                                    std::span<Eigen::Vector2d> points) const {
+
+    if (this->degree > 0 && this->degree <= Bezier::maximumNestedDegree) {
+        simd::evaluateBernstein(this->weightedX.data(), this->weightedY.data(),
+                                this->degree + 1, t, points);
+        return;
+    }
+
+    for (std::size_t i = 0; i < t.size(); i++)
+        points[i] = this->evaluateAt(t[i]);
+}
+
+/**
+ * Evaluates the polynomial without forming any binomial coefficient. The
+ * Bernstein polynomial of largest value, b_k with k = round(n t), is computed
+ * in log space from the table of the polynomial, and the others are obtained
+ * from it with the ratios b_{i+1} / b_i = (n - i) / (i + 1) * t / (1 - t).
+ * Both walks stop once the terms no longer contribute, so the cost is at most
+ * O(n) per point.
+ */
+Eigen::Vector2d Bezier::Polynomial::evaluateHighDegree(double t) const {
+
+    const int n = this->degree;
+
+    if (t <= 0.0) return Eigen::Vector2d(this->x[0], this->y[0]);
+    if (t >= 1.0) return Eigen::Vector2d(this->x[n], this->y[n]);
+
+    const double s = 1.0 - t;
+    const double ratio = t / s;
+    const double epsilon = 1e-18;
+    const int k = static_cast<int>(std::round(n * t));
+
+    const double bk = std::exp(this->logBinomial[k] + k * std::log(t) +
+                               (n - k) * std::log(s));
+
+    double px = bk * this->x[k];
+    double py = bk * this->y[k];
+
+    double b = bk;
+    for (int i = k; i < n && b > epsilon * bk; i++) {
+        b *= ratio * (n - i) / (i + 1);
+        px += b * this->x[i+1];
+        py += b * this->y[i+1];
+    }
+
+    b = bk;
+    for (int i = k; i > 0 && b > epsilon * bk; i--) {
+        b *= i / (ratio * (n - i + 1));
+        px += b * this->x[i-1];
+        py += b * this->y[i-1];
+    }
+
+    return Eigen::Vector2d(px, py);
 }
 
 } /* namespace iphito::math */
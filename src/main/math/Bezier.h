@@ -12,6 +12,7 @@
 #include <utility>
 #include <map>
 #include <memory>
+#include <span>
 #include <Eigen/Core>
 
 #include "Curve.h"
@@ -25,15 +26,72 @@ public:
     ~Bezier();
     
     Eigen::Vector2d evaluateAt(double t) override;
+    void evaluateAt(std::span<const double> t,
+                    std::span<Eigen::Vector2d> points) override;
     std::unique_ptr<Curve> offsetBy(double amount) override;
+    std::vector<Eigen::Vector2d> getBezierPoints() override;
+
+    Eigen::Vector2d derivativeAt(double t) override;
+    void derivativeAt(std::span<const double> t,
+                      std::span<Eigen::Vector2d> derivatives) override;
+    Eigen::Vector2d secondDerivativeAt(double t) override;
+    void secondDerivativeAt(std::span<const double> t,
+                            std::span<Eigen::Vector2d> derivatives) override;
 
     void setPoints(std::vector<Eigen::Vector2d>& points);
     std::vector<Eigen::Vector2d> getPoints();
     std::map<int, std::pair<Eigen::Vector2d, double>> getPointsAndBernstein();
 
+    static std::pair<std::vector<Eigen::Vector2d>,
+                     std::vector<Eigen::Vector2d>>
+        subdivide(const std::vector<Eigen::Vector2d>& points, double t);
+    static std::pair<Eigen::Vector2d, Eigen::Vector2d>
+        bounds(const std::vector<Eigen::Vector2d>& points);
+
 private:
-    std::map<int, std::pair<Eigen::Vector2d, double>> pointsAndBernstein;
-    int degree;
+    /* Above this degree the premultiplied Bernstein coefficients get close to
+     * the double range and evaluation switches to evaluateHighDegree. */
+    static constexpr int maximumNestedDegree = 512;
+
+    /* Halvings isolating the roots of a derivative, and refining them. */
+    static constexpr int maximumRootDepth = 32;
+    static constexpr int bisectionSteps = 52;
+
+    static void isolateRoots(const std::vector<double>& coefficients,
+                             double a, double b, int depth,
+                             std::vector<double>& roots);
+    static double evaluateScalar(std::vector<double> coefficients, double t);
+
+    /**
+     * A 2D polynomial in the Bernstein basis, stored as structure of arrays.
+     * The curve and its first two hodographs are each kept in one.
+     */
+    struct Polynomial {
+        Polynomial(int degree);
+
+        int degree;
+        std::vector<double> x;
+        std::vector<double> y;
+        std::vector<double> binomial;
+        std::vector<double> logBinomial;
+
+        /* Control points premultiplied by their binomial coefficient. */
+        std::vector<double> weightedX;
+        std::vector<double> weightedY;
+
+        void recomputeWeightedPoints();
+        void differentiate(const Polynomial& polynomial);
+        Eigen::Vector2d evaluateAt(double t) const;
+        void evaluateAt(std::span<const double> t,
+                        std::span<Eigen::Vector2d> points) const;
+        Eigen::Vector2d evaluateHighDegree(double t) const;
+    };
+
+    Polynomial curve;
+    Polynomial velocity;
+    Polynomial acceleration;
+
+    void recomputeDerivatives();
 };
 
 } /* namespace iphito::math */
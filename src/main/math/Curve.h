@@ -8,8 +8,13 @@
 #ifndef CURVE_H
 #define CURVE_H
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
 #include <Eigen/Core>
 
 namespace iphito::math {
@@ -19,13 +24,176 @@ class Curve {
 public:
     virtual ~Curve() = 0;
     virtual Eigen::Vector2d evaluateAt(double t) = 0;
+    virtual void evaluateAt(std::span<const double> t,
+                            std::span<Eigen::Vector2d> points);
     virtual Eigen::Vector2d operator()(double t) { return this->evaluateAt(t); }
     virtual std::unique_ptr<Curve> offsetBy(double amount) = 0;
-    
+
+    /* Control points of the same curve expressed in the Bernstein basis. */
+    virtual std::vector<Eigen::Vector2d> getBezierPoints() = 0;
+
+    virtual Eigen::Vector2d derivativeAt(double t) = 0;
+    virtual void derivativeAt(std::span<const double> t,
+                              std::span<Eigen::Vector2d> derivatives);
+    virtual Eigen::Vector2d secondDerivativeAt(double t) = 0;
+    virtual void secondDerivativeAt(std::span<const double> t,
+                                    std::span<Eigen::Vector2d> derivatives);
+
+    double curvatureAt(double t);
+    void curvatureAt(std::span<const double> t, std::span<double> curvatures);
+    Eigen::Vector2d tangentAt(double t);
+    Eigen::Vector2d normalAt(double t);
+    double closestParameterTo(const Eigen::Vector2d& point, double t,
+                              const Eigen::Matrix2d& metric =
+                                  Eigen::Matrix2d::Identity());
+
+    /* Largest number of Newton steps towards the closest point. */
+    static constexpr int closestPointIterations = 16;
+
+private:
+    static double curvature(const Eigen::Vector2d& d1,
+                            const Eigen::Vector2d& d2);
 };
 
 inline Curve::~Curve() {}
 
+/**
+ * Evaluates the curve at every parameter of t and writes the results to
+ * points. Subclasses override it with a vectorized kernel so that callers pay
+ * a single virtual call per batch instead of one per point.
+ */
+inline void Curve::evaluateAt(std::span<const double> t,
+                              std::span<Eigen::Vector2d> points) {
+
+    if (points.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
+    }
+
+    for (std::size_t i = 0; i < t.size(); i++)
+        points[i] = this->evaluateAt(t[i]);
+}
+
+inline void Curve::derivativeAt(std::span<const double> t,
+                                std::span<Eigen::Vector2d> derivatives) {
+
+    if (derivatives.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
+    }
+
+    for (std::size_t i = 0; i < t.size(); i++)
+        derivatives[i] = this->derivativeAt(t[i]);
+}
+
+inline void Curve::secondDerivativeAt(std::span<const double> t,
+                                      std::span<Eigen::Vector2d> derivatives) {
+
+    if (derivatives.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
+    }
+
+    for (std::size_t i = 0; i < t.size(); i++)
+        derivatives[i] = this->secondDerivativeAt(t[i]);
+}
+
+/**
+ * Signed curvature (x'y'' - y'x'') / |r'|^3, positive when the curve turns
+ * counterclockwise. It is zero where the first derivative vanishes.
+ */
+inline double Curve::curvature(const Eigen::Vector2d& d1,
+                               const Eigen::Vector2d& d2) {
+
+    double speed = d1.norm();
+    if (speed == 0.0) return 0.0;
+
+    return (d1[0] * d2[1] - d1[1] * d2[0]) / (speed * speed * speed);
+}
+
+inline double Curve::curvatureAt(double t) {
+
+    return Curve::curvature(this->derivativeAt(t), this->secondDerivativeAt(t));
+}
+
+inline void Curve::curvatureAt(std::span<const double> t,
+                               std::span<double> curvatures) {
+
+    if (curvatures.size() < t.size()) {
+        throw std::length_error("The output has to be at least as large as"
+                                " the parameters.");
+    }
+
+    std::vector<Eigen::Vector2d> d1(t.size());
+    std::vector<Eigen::Vector2d> d2(t.size());
+    this->derivativeAt(t, d1);
+    this->secondDerivativeAt(t, d2);
+
+    for (std::size_t i = 0; i < t.size(); i++)
+        curvatures[i] = Curve::curvature(d1[i], d2[i]);
+}
+
+/**
+ * Unit tangent at t, or the zero vector where the first derivative vanishes.
+ */
+inline Eigen::Vector2d Curve::tangentAt(double t) {
+
+    Eigen::Vector2d d = this->derivativeAt(t);
+    double speed = d.norm();
+
+    return speed == 0.0 ? Eigen::Vector2d::Zero().eval() : (d / speed).eval();
+}
+
+/**
+ * Unit normal at t, the tangent rotated counterclockwise by a quarter turn.
+ */
+inline Eigen::Vector2d Curve::normalAt(double t) {
+
+    Eigen::Vector2d tangent = this->tangentAt(t);
+
+    return Eigen::Vector2d(-tangent[1], tangent[0]);
+}
+
+/**
+ * Parameter in [0, 1] of the point of the curve closest to a point, refined
+ * from the guess t with Newton's method on (C(t) - point) . C'(t) = 0. When
+ * the iteration ends farther from the point than the guess, e.g. at another
+ * stationary point, the guess is kept.
+ *
+ * The distances are measured with the metric M, |v|^2 = v^T M v. The metric
+ * A^T A gives the distances once the curve and the point are mapped by A,
+ * e.g. by the linear part of a model matrix.
+ */
+inline double Curve::closestParameterTo(const Eigen::Vector2d& point,
+                                        double t,
+                                        const Eigen::Matrix2d& metric) {
+
+    const double guess = std::clamp(t, 0.0, 1.0);
+    t = guess;
+
+    for (int i = 0; i < Curve::closestPointIterations; i++) {
+
+        Eigen::Vector2d d = this->evaluateAt(t) - point;
+        Eigen::Vector2d d1 = this->derivativeAt(t);
+        Eigen::Vector2d d2 = this->secondDerivativeAt(t);
+
+        double df = d1.dot(metric * d1) + d.dot(metric * d2);
+        if (df <= 0.0) break;
+
+        double next = std::clamp(t - d.dot(metric * d1) / df, 0.0, 1.0);
+        if (next == t) break;
+
+        t = next;
+    }
+
+    Eigen::Vector2d d = this->evaluateAt(t) - point;
+    Eigen::Vector2d dGuess = this->evaluateAt(guess) - point;
+    if (d.dot(metric * d) > dGuess.dot(metric * dGuess))
+        return guess;
+
+    return t;
+}
+
 } /* namespace iphito::math */
 
 #endif /* ifndef CURVE_H */
@@ -0,0 +1,369 @@
+/**
+ * @file Hermite.h
+ * @brief Describes a Hermite curve of odd degree with fixed-size storage
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-02-20
+ */
+#ifndef HERMITE_H
+#define HERMITE_H
+
+#include <array>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <Eigen/Core>
+
+#include "Curve.h"
+#include "Simd.h"
+#include "src/main/utils/Utils.h"
+
+namespace iphito::math {
+
+/**
+ * Power basis coefficients of the Hermite basis functions, one row per
+ * geometry vector, highest power first. The geometry vectors are ordered as
+ * the start derivatives by increasing order followed by the end derivatives
+ * by decreasing order, e.g. (P0, T0, T1, P1) for the cubic curve.
+ */
+template <int Degree>
+struct HermiteBasis;
+
+template <>
+struct HermiteBasis<3> {
+    static constexpr std::array<double, 16> coefficients = {
+         2.0, -3.0,  0.0,  1.0,
+         1.0, -2.0,  1.0,  0.0,
+         1.0, -1.0,  0.0,  0.0,
+        -2.0,  3.0,  0.0,  0.0
+    };
+};
+
+template <>
+struct HermiteBasis<5> {
+    static constexpr std::array<double, 36> coefficients = {
+        -6.0,  15.0, -10.0, 0.0, 0.0, 1.0,
+        -3.0,   8.0,  -6.0, 0.0, 1.0, 0.0,
+        -0.5,   1.5,  -1.5, 0.5, 0.0, 0.0,
+         0.5,  -1.0,   0.5, 0.0, 0.0, 0.0,
+        -3.0,   7.0,  -4.0, 0.0, 0.0, 0.0,
+         6.0, -15.0,  10.0, 0.0, 0.0, 0.0
+    };
+};
+
+/**
+ * A Hermite curve of the given odd degree, described by the first
+ * (Degree + 1) / 2 derivatives (the point itself being the 0th) at both of its
+ * ends. All the storage is fixed-size, so evaluation and the setters never
+ * allocate.
+ */
+template <int Degree>
+class Hermite : public Curve {
+
+    static_assert(Degree % 2 == 1, "Hermite curves have an odd degree.");
+
+public:
+    static constexpr int order = (Degree + 1) / 2;
+
+    typedef Eigen::Matrix<double, 2, Degree + 1> CurveMatrix;
+    typedef Eigen::Matrix<double, Degree + 1, Degree + 1, Eigen::RowMajor>
+        BasisMatrix;
+
+    /**
+     * @param vectors the start derivatives followed by the end derivatives,
+     * both by increasing order, e.g. (P0, T0, P1, T1) for the cubic curve.
+     */
+    template <typename... Vectors>
+        requires (sizeof...(Vectors) == Degree + 1)
+    Hermite(const Vectors&... vectors) {
+
+        const std::array<Eigen::Vector2d, Degree + 1> v = {vectors...};
+
+        for (int i = 0; i < order; i++) {
+            this->start.col(i) = v[i];
+            this->end.col(i) = v[order + i];
+        }
+
+        this->recomputeB();
+    }
+
+    ~Hermite() {}
+
+    Eigen::Vector2d evaluateAt(double t) override {
+
+        if(t < 0.0) t = 0.0;
+        if(t > 1.0) t = 1.0;
+
+        Eigen::Vector2d p = this->B.col(0);
+        for (int j = 1; j <= Degree; j++) p = p * t + this->B.col(j);
+
+        return p;
+    }
+
+    void evaluateAt(std::span<const double> t,
+                    std::span<Eigen::Vector2d> points) override {
+
+        if (points.size() < t.size()) {
+            throw std::length_error("The output has to be at least as large as"
+                                    " the parameters.");
+        }
+
+        simd::evaluatePowerBasis(this->B.data(), Degree + 1, t, points);
+    }
+
+    std::unique_ptr<Curve> offsetBy(double amount) override {
+
+        return std::make_unique<Hermite<Degree>>(*this);
+    }
+
+    /**
+     * Converts the power basis coefficients a_p of B to the Bernstein basis:
+     * P_i = sum over p <= i of C(i, p) / C(Degree, p) a_p.
+     */
+    std::vector<Eigen::Vector2d> getBezierPoints() override {
+
+        using iphito::utils::Utils;
+
+        std::vector<Eigen::Vector2d> points(Degree + 1,
+                                            Eigen::Vector2d::Zero());
+
+        for (int i = 0; i <= Degree; i++) {
+            for (int p = 0; p <= i; p++) {
+                points[i] += Utils::binomial(i, p) /
+                             Utils::binomial(Degree, p) *
+                             this->B.col(Degree - p);
+            }
+        }
+
+        return points;
+    }
+
+    Eigen::Vector2d derivativeAt(double t) override {
+
+        if(t < 0.0) t = 0.0;
+        if(t > 1.0) t = 1.0;
+
+        Eigen::Vector2d d = this->dB.col(0);
+        for (int j = 1; j < Degree; j++) d = d * t + this->dB.col(j);
+
+        return d;
+    }
+
+    void derivativeAt(std::span<const double> t,
+                      std::span<Eigen::Vector2d> derivatives) override {
+
+        if (derivatives.size() < t.size()) {
+            throw std::length_error("The output has to be at least as large as"
+                                    " the parameters.");
+        }
+
+        simd::evaluatePowerBasis(this->dB.data(), Degree, t, derivatives);
+    }
+
+    Eigen::Vector2d secondDerivativeAt(double t) override {
+
+        if(t < 0.0) t = 0.0;
+        if(t > 1.0) t = 1.0;
+
+        Eigen::Vector2d d = this->ddB.col(0);
+        for (int j = 1; j < Degree - 1; j++) d = d * t + this->ddB.col(j);
+
+        return d;
+    }
+
+    void secondDerivativeAt(std::span<const double> t,
+                            std::span<Eigen::Vector2d> derivatives) override {
+
+        if (derivatives.size() < t.size()) {
+            throw std::length_error("The output has to be at least as large as"
+                                    " the parameters.");
+        }
+
+        simd::evaluatePowerBasis(this->ddB.data(), Degree - 1, t, derivatives);
+    }
+
+    void setStartDerivative(int k, const Eigen::Vector2d& v) {
+
+        this->start.col(k) = v;
+        this->recomputeB();
+    }
+
+    void setEndDerivative(int k, const Eigen::Vector2d& v) {
+
+        this->end.col(k) = v;
+        this->recomputeB();
+    }
+
+    Eigen::Vector2d getStartDerivative(int k) { return this->start.col(k); }
+    Eigen::Vector2d getEndDerivative(int k) { return this->end.col(k); }
+    CurveMatrix getCurveMatrix() { return this->B; }
+
+    static Eigen::Map<const BasisMatrix> basis() {
+        return Eigen::Map<const BasisMatrix>(
+                HermiteBasis<Degree>::coefficients.data());
+    }
+
+    // Control points, shared by every degree.
+
+    void setStartControlPoint(Eigen::Vector2d p) {
+        this->setStartDerivative(0, p);
+    }
+
+    void setEndControlPoint(Eigen::Vector2d p) {
+        this->setEndDerivative(0, p);
+    }
+
+    Eigen::Vector2d getStartControlPoint() { return this->start.col(0); }
+    Eigen::Vector2d getEndControlPoint() { return this->end.col(0); }
+
+    // Cubic curve vocabulary.
+
+    void setControlPoints(Eigen::Vector2d startPoint, Eigen::Vector2d endPoint)
+        requires (Degree == 3) {
+
+        this->start.col(0) = startPoint;
+        this->end.col(0) = endPoint;
+        this->recomputeB();
+    }
+
+    void setStartTangentVector(Eigen::Vector2d t) requires (Degree == 3) {
+        this->setStartDerivative(1, t);
+    }
+
+    void setEndTangentVector(Eigen::Vector2d t) requires (Degree == 3) {
+        this->setEndDerivative(1, t);
+    }
+
+    void setTangentVectors(Eigen::Vector2d startTangentVector,
+                           Eigen::Vector2d endTangentVector)
+        requires (Degree == 3) {
+
+        this->start.col(1) = startTangentVector;
+        this->end.col(1) = endTangentVector;
+        this->recomputeB();
+    }
+
+    void setCurveDescription(Eigen::Vector2d startPoint,
+                             Eigen::Vector2d startTangentVector,
+                             Eigen::Vector2d endPoint,
+                             Eigen::Vector2d endTangentVector)
+        requires (Degree == 3) {
+
+        this->start << startPoint, startTangentVector;
+        this->end << endPoint, endTangentVector;
+        this->recomputeB();
+    }
+
+    Eigen::Vector2d getStartTangentVector() requires (Degree == 3) {
+        return this->start.col(1);
+    }
+
+    Eigen::Vector2d getEndTangentVector() requires (Degree == 3) {
+        return this->end.col(1);
+    }
+
+    // Quintic curve vocabulary.
+
+    void setControlControlPoints(Eigen::Vector2d startControlPoint,
+                                 Eigen::Vector2d endControlPoint)
+        requires (Degree == 5) {
+
+        this->start.col(0) = startControlPoint;
+        this->end.col(0) = endControlPoint;
+        this->recomputeB();
+    }
+
+    void setStartVelocityVector(Eigen::Vector2d v) requires (Degree == 5) {
+        this->setStartDerivative(1, v);
+    }
+
+    void setEndVelocityVector(Eigen::Vector2d v) requires (Degree == 5) {
+        this->setEndDerivative(1, v);
+    }
+
+    void setVelocityVectors(Eigen::Vector2d startVelocityVector,
+                            Eigen::Vector2d endVelocityVector)
+        requires (Degree == 5) {
+
+        this->start.col(1) = startVelocityVector;
+        this->end.col(1) = endVelocityVector;
+        this->recomputeB();
+    }
+
+    void setStartAccelerationVector(Eigen::Vector2d a) requires (Degree == 5) {
+        this->setStartDerivative(2, a);
+    }
+
+    void setEndAccelerationVector(Eigen::Vector2d a) requires (Degree == 5) {
+        this->setEndDerivative(2, a);
+    }
+
+    void setAccelerationVectors(Eigen::Vector2d startAccelerationVector,
+                                Eigen::Vector2d endAccelerationVector)
+        requires (Degree == 5) {
+
+        this->start.col(2) = startAccelerationVector;
+        this->end.col(2) = endAccelerationVector;
+        this->recomputeB();
+    }
+
+    void setCurveDescription(Eigen::Vector2d startControlPoint,
+                             Eigen::Vector2d startVelocityVector,
+                             Eigen::Vector2d startAccelerationVector,
+                             Eigen::Vector2d endControlPoint,
+                             Eigen::Vector2d endVelocityVector,
+                             Eigen::Vector2d endAccelerationVector)
+        requires (Degree == 5) {
+
+        this->start << startControlPoint, startVelocityVector,
+                       startAccelerationVector;
+        this->end << endControlPoint, endVelocityVector,
+                     endAccelerationVector;
+        this->recomputeB();
+    }
+
+    Eigen::Vector2d getStartVelocityVector() requires (Degree == 5) {
+        return this->start.col(1);
+    }
+
+    Eigen::Vector2d getEndVelocityVector() requires (Degree == 5) {
+        return this->end.col(1);
+    }
+
+    Eigen::Vector2d getStartAccelerationVector() requires (Degree == 5) {
+        return this->start.col(2);
+    }
+
+    Eigen::Vector2d getEndAccelerationVector() requires (Degree == 5) {
+        return this->end.col(2);
+    }
+
+private:
+    Eigen::Matrix<double, 2, order> start;
+    Eigen::Matrix<double, 2, order> end;
+
+    CurveMatrix B;
+
+    /* B differentiated once and twice, still highest power first. */
+    Eigen::Matrix<double, 2, Degree> dB;
+    Eigen::Matrix<double, 2, Degree - 1> ddB;
+
+    void recomputeB() {
+
+        CurveMatrix G;
+        G << this->start, this->end.rowwise().reverse();
+
+        this->B.noalias() = G * Hermite::basis();
+
+        for (int j = 0; j < Degree; j++)
+            this->dB.col(j) = (Degree - j) * this->B.col(j);
+
+        for (int j = 0; j < Degree - 1; j++)
+            this->ddB.col(j) = (Degree - 1 - j) * this->dB.col(j);
+    }
+};
+
+} /* namespace iphito::math */
+
+#endif /* ifndef HERMITE_H */
@@ -0,0 +1,227 @@
+/**
+ * @file Simd.h
+ * @brief Describes the SIMD packs and kernels used for batch curve evaluation
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-02-06
+ */
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <span>
+#include <Eigen/Core>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace iphito::math::simd {
+
+/**
+ * A pack holds as many doubles as the widest instruction set the translation
+ * unit is compiled for: four with AVX/AVX2, two with SSE2 and one otherwise.
+ * The kernels below are written once against this interface.
+ */
+#if defined(__AVX__)
+
+struct Pack {
+    static constexpr int width = 4;
+    __m256d v;
+};
+
+inline Pack broadcast(double a) { return {_mm256_set1_pd(a)}; }
+inline Pack load(const double* p) { return {_mm256_loadu_pd(p)}; }
+inline Pack operator+(Pack a, Pack b) { return {_mm256_add_pd(a.v, b.v)}; }
+inline Pack operator-(Pack a, Pack b) { return {_mm256_sub_pd(a.v, b.v)}; }
+inline Pack operator*(Pack a, Pack b) { return {_mm256_mul_pd(a.v, b.v)}; }
+inline Pack min(Pack a, Pack b) { return {_mm256_min_pd(a.v, b.v)}; }
+inline Pack max(Pack a, Pack b) { return {_mm256_max_pd(a.v, b.v)}; }
+
+inline Pack multiplyAdd(Pack a, Pack b, Pack c) {
+#if defined(__FMA__)
+    return {_mm256_fmadd_pd(a.v, b.v, c.v)};
+#else
+    return {_mm256_add_pd(_mm256_mul_pd(a.v, b.v), c.v)};
+#endif
+}
+
+/* Writes x0 y0 x1 y1 x2 y2 x3 y3 to dst. */
+inline void storeInterleaved(double* dst, Pack x, Pack y) {
+    __m256d low = _mm256_unpacklo_pd(x.v, y.v);
+    __m256d high = _mm256_unpackhi_pd(x.v, y.v);
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(low, high, 0x20));
+    _mm256_storeu_pd(dst + 4, _mm256_permute2f128_pd(low, high, 0x31));
+}
+
+#elif defined(__SSE2__)
+
+struct Pack {
+    static constexpr int width = 2;
+    __m128d v;
+};
+
+inline Pack broadcast(double a) { return {_mm_set1_pd(a)}; }
+inline Pack load(const double* p) { return {_mm_loadu_pd(p)}; }
+inline Pack operator+(Pack a, Pack b) { return {_mm_add_pd(a.v, b.v)}; }
+inline Pack operator-(Pack a, Pack b) { return {_mm_sub_pd(a.v, b.v)}; }
+inline Pack operator*(Pack a, Pack b) { return {_mm_mul_pd(a.v, b.v)}; }
+inline Pack min(Pack a, Pack b) { return {_mm_min_pd(a.v, b.v)}; }
+inline Pack max(Pack a, Pack b) { return {_mm_max_pd(a.v, b.v)}; }
+
+inline Pack multiplyAdd(Pack a, Pack b, Pack c) {
+    return {_mm_add_pd(_mm_mul_pd(a.v, b.v), c.v)};
+}
+
+inline void storeInterleaved(double* dst, Pack x, Pack y) {
+    _mm_storeu_pd(dst, _mm_unpacklo_pd(x.v, y.v));
+    _mm_storeu_pd(dst + 2, _mm_unpackhi_pd(x.v, y.v));
+}
+
+#else
+
+struct Pack {
+    static constexpr int width = 1;
+    double v;
+};
+
+inline Pack broadcast(double a) { return {a}; }
+inline Pack load(const double* p) { return {*p}; }
+inline Pack operator+(Pack a, Pack b) { return {a.v + b.v}; }
+inline Pack operator-(Pack a, Pack b) { return {a.v - b.v}; }
+inline Pack operator*(Pack a, Pack b) { return {a.v * b.v}; }
+inline Pack min(Pack a, Pack b) { return {a.v < b.v ? a.v : b.v}; }
+inline Pack max(Pack a, Pack b) { return {a.v > b.v ? a.v : b.v}; }
+inline Pack multiplyAdd(Pack a, Pack b, Pack c) { return {a.v * b.v + c.v}; }
+
+inline void storeInterleaved(double* dst, Pack x, Pack y) {
+    dst[0] = x.v;
+    dst[1] = y.v;
+}
+
+#endif
+
+/**
+ * Evaluates a 2D polynomial given in the power basis with Horner's scheme.
+ *
+ * @param coefficients interleaved (x, y) coefficients, highest power first,
+ * i.e. the column-major data of a 2 x columns curve matrix.
+ * @param columns the number of coefficients per coordinate (degree + 1).
+ * @param t the parameters, clamped to [0, 1] when clamp is set.
+ * @param points the output, at least as large as t.
+ */
+template <typename P>
+inline void evaluatePowerBasis(const double* coefficients, int columns, P t,
+                               double* points, bool clamp) {
+
+    P x = broadcast(coefficients[0]);
+    P y = broadcast(coefficients[1]);
+
+    if (clamp) t = min(max(t, broadcast(0.0)), broadcast(1.0));
+
+    for (int j = 1; j < columns; j++) {
+        x = multiplyAdd(x, t, broadcast(coefficients[2*j]));
+        y = multiplyAdd(y, t, broadcast(coefficients[2*j + 1]));
+    }
+
+    storeInterleaved(points, x, y);
+}
+
+inline void evaluatePowerBasis(const double* coefficients, int columns,
+                               std::span<const double> t,
+                               std::span<Eigen::Vector2d> points,
+                               bool clamp = true) {
+
+    if (t.empty()) return;
+
+    std::size_t i = 0;
+    double* out = points.data()->data();
+
+    for (; i + Pack::width <= t.size(); i += Pack::width) {
+        evaluatePowerBasis(coefficients, columns, load(&t[i]), out + 2*i,
+                           clamp);
+    }
+
+    for (; i < t.size(); i++) {
+        double ti = t[i];
+        if (clamp) ti = ti < 0.0 ? 0.0 : (ti > 1.0 ? 1.0 : ti);
+
+        double x = coefficients[0];
+        double y = coefficients[1];
+        for (int j = 1; j < columns; j++) {
+            x = x * ti + coefficients[2*j];
+            y = y * ti + coefficients[2*j + 1];
+        }
+        points[i] = Eigen::Vector2d(x, y);
+    }
+}
+
+/**
+ * Evaluates a 2D polynomial given in the Bernstein basis in O(n) per point,
+ * using the nested form
+ * ((W0 s + t W1) s + t^2 W2) s + ... + t^n Wn with s = 1 - t.
+ *
+ * @param x, y the control point coordinates already multiplied by their
+ * binomial coefficient, lowest index first.
+ * @param count the number of control points (degree + 1), at least two.
+ */
+template <typename P>
+inline void evaluateBernstein(const double* x, const double* y, int count,
+                              P t, double* points) {
+
+    P s = broadcast(1.0) - t;
+    P power = broadcast(1.0);
+    P px = broadcast(x[0]) * s;
+    P py = broadcast(y[0]) * s;
+
+    for (int i = 1; i < count - 1; i++) {
+        power = power * t;
+        px = multiplyAdd(power, broadcast(x[i]), px) * s;
+        py = multiplyAdd(power, broadcast(y[i]), py) * s;
+    }
+
+    power = power * t;
+    px = multiplyAdd(power, broadcast(x[count-1]), px);
+    py = multiplyAdd(power, broadcast(y[count-1]), py);
+
+    storeInterleaved(points, px, py);
+}
+
+inline Eigen::Vector2d evaluateBernstein(const double* x, const double* y,
+                                         int count, double t) {
+
+    double s = 1.0 - t;
+    double power = 1.0;
+    double px = x[0] * s;
+    double py = y[0] * s;
+
+    for (int i = 1; i < count - 1; i++) {
+        power *= t;
+        px = (px + power * x[i]) * s;
+        py = (py + power * y[i]) * s;
+    }
+
+    power *= t;
+    return Eigen::Vector2d(px + power * x[count-1], py + power * y[count-1]);
+}
+
+inline void evaluateBernstein(const double* x, const double* y, int count,
+                              std::span<const double> t,
+                              std::span<Eigen::Vector2d> points) {
+
+    if (t.empty()) return;
+
+    std::size_t i = 0;
+    double* out = points.data()->data();
+
+    for (; i + Pack::width <= t.size(); i += Pack::width) {
+        evaluateBernstein(x, y, count, load(&t[i]), out + 2*i);
+    }
+
+    for (; i < t.size(); i++) {
+        points[i] = evaluateBernstein(x, y, count, t[i]);
+    }
+}
+
+} /* namespace iphito::math::simd */
+
+#endif /* ifndef SIMD_H */
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <limits>
 
 #include "AABB.h"
 
@@ -44,4 +45,63 @@ const AABB AABB::operator-=(const AABB& b) const {
     return *this - b;
 }
 
+/**
+ * Whether the boxes share a point, which an empty box never does.
+ */
+bool AABB::intersects(const AABB& b) const {
+    Eigen::Vector2d min = this->min.cwiseMax(b.min);
+    Eigen::Vector2d max = this->max.cwiseMin(b.max);
+    return min[0] <= max[0] && min[1] <= max[1];
+}
+
+bool AABB::contains(const AABB& b) const {
+    return this->min[0] <= b.min[0] && b.max[0] <= this->max[0] &&
+           this->min[1] <= b.min[1] && b.max[1] <= this->max[1];
+}
+
+bool AABB::contains(const Eigen::Vector2d& p) const {
+    return this->min[0] <= p[0] && p[0] <= this->max[0] &&
+           this->min[1] <= p[1] && p[1] <= this->max[1];
+}
+
+/**
+ * Grows the box by margin times its size on every side.
+ */
+AABB AABB::expandedBy(double margin) const {
+    Eigen::Vector2d delta = margin * (this->max - this->min);
+    return AABB(this->min - delta, this->max + delta);
+}
+
+AABB AABB::fromPoints(const std::vector<Eigen::Vector2d>& points) {
+    if (points.empty()) return AABB();
+
+    Eigen::Vector2d min = points[0];
+    Eigen::Vector2d max = points[0];
+
+    for (auto& i : points) {
+        min = min.cwiseMin(i);
+        max = max.cwiseMax(i);
+    }
+
+    return AABB(min, max);
+}
+
+/**
+ * The box containing every point, e.g. when nothing is culled.
+ */
+AABB AABB::unbounded() {
+    const double infinity = std::numeric_limits<double>::infinity();
+    return AABB(Eigen::Vector2d(-infinity, -infinity),
+                Eigen::Vector2d(infinity, infinity));
+}
+
+/**
+ * The box containing no point, neutral for the union.
+ */
+AABB AABB::empty() {
+    const double infinity = std::numeric_limits<double>::infinity();
+    return AABB(Eigen::Vector2d(infinity, infinity),
+                Eigen::Vector2d(-infinity, -infinity));
+}
+
 } /* namespace iphito::renderer */
@@ -1,6 +1,7 @@
 #ifndef AABB_H
 #define AABB_H
 
+#include <vector>
 #include <Eigen/Core>
 
 namespace iphito::renderer {
@@ -19,6 +20,15 @@ public:
     const AABB operator-(const AABB& b) const;
     const AABB operator-=(const AABB& b) const;
 
+    bool intersects(const AABB& b) const;
+    bool contains(const AABB& b) const;
+    bool contains(const Eigen::Vector2d& p) const;
+    AABB expandedBy(double margin) const;
+
+    static AABB fromPoints(const std::vector<Eigen::Vector2d>& points);
+    static AABB unbounded();
+    static AABB empty();
+
 private:
     Eigen::Vector2d min;
     Eigen::Vector2d max;
@@ -6,6 +6,7 @@
  * @date 2018-12-26
  */
 #include "Arrow2D.h"
+#include "ShaderRegistry.h"
 
 #include "src/main/utils/Utils.h"
 #include "src/main/utils/Logger.h"
@@ -28,15 +29,8 @@ Arrow2D::Arrow2D(const Eigen::Vector2d& position,
     if(!Utils::isGlewInitialized())
         throw std::runtime_error("Please initialize Glew.");
 
-    this->shader.reset(new Shader("../src/shaders/basic.vert",
-                                  "../src/shaders/basic.frag"));
-
-    this->shader->useProgram();
-
-    int colorLocation = glGetUniformLocation(this->shader->getProgramID(),
-                                             "color");
-    glUniform3f(colorLocation, this->color[0], this->color[1],
-                this->color[2]);
+    this->shader = ShaderRegistry::Instance()->get(
+            "basic.vert", "basic.frag");
 
     glGenVertexArrays(1, &this->vertexArrayObjectID);
     glBindVertexArray(this->vertexArrayObjectID);
@@ -132,8 +126,7 @@ void Arrow2D::render() {
 
     this->shader->useProgram();
     this->shader->setMatrix4("model", this->model);
-    this->shader->setMatrix4("view", this->view);
-    this->shader->setMatrix4("projection", this->projection);
+    this->shader->setVector3("color", this->color);
 
     glBindVertexArray(this->vertexArrayObjectID);
     glDrawElements(GL_TRIANGLES, this->indices.size(), GL_UNSIGNED_INT, NULL);
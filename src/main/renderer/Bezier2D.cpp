@@ -26,68 +26,39 @@ Bezier2D::Bezier2D(std::shared_ptr<Bezier> curve, double curveWidth,
 
     std::vector<Eigen::Vector2d> points = this->curve->getPoints();
 
-    for (auto& i : points) {
-        std::unique_ptr<Point2D> p(new Point2D(i, this->controlPointsColor,
-                                               0.015));
-        this->controlPoints.push_back(std::move(p));
-    }
-
-    for (int i = 0; i < points.size() - 1; i++) {
-        std::unique_ptr<Line2D> l(new Line2D(points[i], points[i+1], 0.0025,
-                                  this->controlPointsColor));
-        this->controlPolygon.push_back(std::move(l));
-    }
+    this->controlPolygon.reset(new InstancedOverlay());
+    this->controlPoints.reset(new InstancedOverlay());
+
+    for (auto& i : points)
+        this->controlPoints->addCircle(i, 0.015, this->controlPointsColor);
+
+    for (int i = 0; i < points.size() - 1; i++)
+        this->controlPolygon->addSegment(points[i], points[i+1], 0.0025,
+                                         this->controlPointsColor);
 }
 
 Bezier2D::~Bezier2D() {
     // TODO: Correctly destroy everything
 }
 
-void Bezier2D::render() {
-
-    if (this->hasToBeRedrawn()) {
-        this->recomputeVerticesAndIndices();
-    }
-
-    if (Curve2D::viewMatrixUpdate) {
-
-        for (auto& i : this->controlPolygon)
-            i->updateViewMatrix(Curve2D::view);
-
-        for (auto& i : this->controlPoints)
-            i->updateViewMatrix(Curve2D::view);
+void Bezier2D::renderUnderlay() {
 
-        Curve2D::viewMatrixUpdate = false;
-    }
-
-    if (Curve2D::projectionMatrixUpdate) {
-
-        for (auto& i : this->controlPolygon)
-            i->updateProjectionMatrix(Curve2D::projection);
+    this->controlPolygon->render(Curve2D::model, Curve2D::depth);
+}
 
-        for (auto& i : this->controlPoints)
-            i->updateProjectionMatrix(Curve2D::projection);
+void Bezier2D::renderOverlay() {
 
-        Curve2D::projectionMatrixUpdate = false;
-    }
+    this->controlPoints->render(Curve2D::model, Curve2D::depth);
+}
 
-    for (auto& i : this->controlPolygon)
-        i->render();
+AABB Bezier2D::decorationAABB() {
 
-    Curve2D::shader->useProgram();
-    Curve2D::shader->setMatrix4("model", Curve2D::model);
-    Curve2D::shader->setMatrix4("view", Curve2D::view);
-    Curve2D::shader->setMatrix4("projection", Curve2D::projection);
-    glBindVertexArray(Curve2D::vertexArrayObjectID);
-    glDrawElements(GL_TRIANGLES, Curve2D::indices.size(), GL_UNSIGNED_INT,
-                   NULL);
-    glBindVertexArray(0);
+    return this->controlPolygon->getAABB() + this->controlPoints->getAABB();
+}
 
-    for (auto& i : this->controlPoints)
-        i->render();
+bool Bezier2D::hasToBeRedrawn() {
 
+    return Curve2D::isDirty || Curve2D::isUploadPending;
 }
 
-bool Bezier2D::hasToBeRedrawn() { return Curve2D::isDirty; }
-
 } /* namespace iphito::renderer */
@@ -13,9 +13,7 @@
 
 #include "src/main/math/Bezier.h"
 #include "Curve2D.h"
-#include "Arrow2D.h"
-#include "Point2D.h"
-#include "Line2D.h"
+#include "InstancedOverlay.h"
 
 namespace iphito::renderer {
 
@@ -29,15 +27,17 @@ public:
              const Eigen::Vector3d& controlPolygonColor);
     ~Bezier2D();
     
-    void render();
     bool hasToBeRedrawn();
+    void renderUnderlay() override;
+    void renderOverlay() override;
+    AABB decorationAABB() override;
 
 private:
     std::shared_ptr<iphito::math::Bezier> curve;
     Eigen::Vector3d controlPointsColor;
     Eigen::Vector3d controlPolygonColor;
-    std::vector<std::unique_ptr<Point2D>> controlPoints;
-    std::vector<std::unique_ptr<Line2D>> controlPolygon;
+    std::unique_ptr<InstancedOverlay> controlPoints;
+    std::unique_ptr<InstancedOverlay> controlPolygon;
 };
 
 } /* namespace iphito::renderer */
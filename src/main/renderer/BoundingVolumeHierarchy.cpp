@@ -0,0 +1,121 @@
+/**
+ * @file BoundingVolumeHierarchy.cpp
+ * @brief Implements a bounding volume hierarchy over axis aligned boxes
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-15
+ */
+#include <algorithm>
+#include <numeric>
+
+#include "BoundingVolumeHierarchy.h"
+
+namespace iphito::renderer {
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() {}
+
+void BoundingVolumeHierarchy::build(const std::vector<AABB>& boxes) {
+
+    this->boxes = boxes;
+    this->nodes.clear();
+    this->items.resize(boxes.size());
+    this->centers.resize(boxes.size());
+
+    std::iota(this->items.begin(), this->items.end(), 0);
+
+    /* Empty and unbounded boxes have no center, and are put at the origin. */
+    for (std::size_t i = 0; i < boxes.size(); i++) {
+        this->centers[i] = 0.5 * (this->boxes[i].getMin() +
+                                  this->boxes[i].getMax());
+        if (!this->centers[i].allFinite()) this->centers[i].setZero();
+    }
+
+    if (!boxes.empty()) this->buildNode(0, boxes.size());
+}
+
+/**
+ * Appends the indices of the boxes intersecting the region, in increasing
+ * order.
+ */
+void BoundingVolumeHierarchy::query(const AABB& region,
+                                    std::vector<int>& indices) {
+
+    if (this->nodes.empty()) return;
+
+    std::size_t start = indices.size();
+    std::vector<int> stack = {0};
+
+    while (!stack.empty()) {
+        const Node& node = this->nodes[stack.back()];
+        int index = stack.back();
+        stack.pop_back();
+
+        if (!node.box.intersects(region)) continue;
+
+        if (node.count > 0) {
+            for (int i = node.first; i < node.first + node.count; i++) {
+                int item = this->items[i];
+                if (this->boxes[item].intersects(region))
+                    indices.push_back(item);
+            }
+        }
+        else {
+            stack.push_back(node.right);
+            stack.push_back(index + 1);
+        }
+    }
+
+    std::sort(indices.begin() + start, indices.end());
+}
+
+/**
+ * The box containing all the boxes.
+ */
+AABB BoundingVolumeHierarchy::getAABB() {
+
+    if (this->nodes.empty()) return AABB::empty();
+    return this->nodes[0].box;
+}
+
+/**
+ * Builds the subtree of items[first, first + count) and returns the index of
+ * its root.
+ */
+int BoundingVolumeHierarchy::buildNode(int first, int count) {
+
+    int index = this->nodes.size();
+    this->nodes.push_back({AABB::empty(), first, count, -1});
+
+    AABB box = AABB::empty();
+    AABB centerBox = AABB::empty();
+    for (int i = first; i < first + count; i++) {
+        int item = this->items[i];
+        box = box + this->boxes[item];
+        centerBox = centerBox + AABB(this->centers[item],
+                                     this->centers[item]);
+    }
+    this->nodes[index].box = box;
+
+    if (count <= BoundingVolumeHierarchy::leafSize) return index;
+
+    Eigen::Vector2d extent = centerBox.getMax() - centerBox.getMin();
+    int axis = extent[0] >= extent[1] ? 0 : 1;
+    int half = count / 2;
+
+    std::nth_element(this->items.begin() + first,
+                     this->items.begin() + first + half,
+                     this->items.begin() + first + count,
+                     [this, axis](int a, int b) {
+                         return this->centers[a][axis] <
+                                this->centers[b][axis];
+                     });
+
+    this->nodes[index].count = 0;
+    this->buildNode(first, half);
+    int right = this->buildNode(first + half, count - half);
+    this->nodes[index].right = right;
+
+    return index;
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,60 @@
+/**
+ * @file BoundingVolumeHierarchy.h
+ * @brief Describes a bounding volume hierarchy over axis aligned boxes
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-15
+ */
+#ifndef BOUNDING_VOLUME_HIERARCHY_H
+#define BOUNDING_VOLUME_HIERARCHY_H
+
+#include <vector>
+
+#include "AABB.h"
+
+namespace iphito::renderer {
+
+/**
+ * A binary tree of boxes, each node bounding the boxes below it, built top
+ * down by splitting the boxes of a node at the median of their centers along
+ * the longest side of the node. Finding the boxes intersecting a region then
+ * only visits the nodes intersecting it.
+ *
+ * The boxes are referred to by their index in the list the hierarchy was
+ * built from. The nodes are stored depth first in an array, the left child of
+ * a node directly following it.
+ */
+class BoundingVolumeHierarchy {
+
+public:
+    BoundingVolumeHierarchy();
+
+    void build(const std::vector<AABB>& boxes);
+    void query(const AABB& region, std::vector<int>& indices);
+    AABB getAABB();
+
+    /* Largest number of boxes in a leaf. */
+    static constexpr int leafSize = 4;
+
+private:
+    struct Node {
+        AABB box;
+
+        /* Range of the boxes of a leaf in items, count being 0 for the other
+         * nodes. */
+        int first;
+        int count;
+        int right;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> items;
+    std::vector<AABB> boxes;
+    std::vector<Eigen::Vector2d> centers;
+
+    int buildNode(int first, int count);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef BOUNDING_VOLUME_HIERARCHY_H */
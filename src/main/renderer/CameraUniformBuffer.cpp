@@ -0,0 +1,62 @@
+/**
+ * @file CameraUniformBuffer.cpp
+ * @brief Implements the uniform buffer sharing the camera matrices between all
+ * the shader programs
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-10
+ */
+#include <stdexcept>
+
+#include "CameraUniformBuffer.h"
+
+#include "src/main/utils/Utils.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::utils;
+
+CameraUniformBuffer::CameraUniformBuffer() {
+
+    if(!Utils::isGlfwInitialized())
+        throw std::runtime_error("Please initialize GLFW.");
+
+    if(!Utils::isGlewInitialized())
+        throw std::runtime_error("Please initialize Glew.");
+
+    glGenBuffers(1, &this->bufferID);
+    glBindBuffer(GL_UNIFORM_BUFFER, this->bufferID);
+    glBufferData(GL_UNIFORM_BUFFER, CameraUniformBuffer::blockSize, NULL,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, CameraUniformBuffer::bindingPoint,
+                     this->bufferID);
+}
+
+CameraUniformBuffer::~CameraUniformBuffer() {
+
+    glDeleteBuffers(1, &this->bufferID);
+}
+
+/**
+ * Eigen stores the matrices column major, which is the std140 layout of a
+ * mat4. The vec2 follows them directly, its offset being a multiple of its
+ * alignment.
+ */
+void CameraUniformBuffer::update(const Eigen::Matrix4d& view,
+                                 const Eigen::Matrix4d& projection,
+                                 const Eigen::Vector2d& viewport) {
+
+    Eigen::Matrix<GLfloat, 4, 8> matrices;
+    matrices << view.cast<GLfloat>(), projection.cast<GLfloat>();
+    Eigen::Vector2f size = viewport.cast<GLfloat>();
+
+    glBindBuffer(GL_UNIFORM_BUFFER, this->bufferID);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(matrices), matrices.data());
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(matrices), sizeof(size),
+                    size.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,53 @@
+/**
+ * @file CameraUniformBuffer.h
+ * @brief Describes the uniform buffer sharing the camera matrices between all
+ * the shader programs
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-10
+ */
+#ifndef CAMERA_UNIFORM_BUFFER_H
+#define CAMERA_UNIFORM_BUFFER_H
+
+#include <Eigen/Core>
+#include <GL/glew.h>
+
+namespace iphito::renderer {
+
+/**
+ * Holds the view and projection matrices and the size of the viewport in
+ * pixels in the std140 layout of the Camera uniform block:
+ *
+ *     layout(std140) uniform Camera {
+ *         mat4 view;
+ *         mat4 projection;
+ *         vec2 viewport;
+ *     };
+ *
+ * The buffer is bound to a fixed binding point, to which every program binds
+ * its Camera block, so the matrices are uploaded once per frame for all the
+ * objects.
+ */
+class CameraUniformBuffer {
+
+public:
+    CameraUniformBuffer();
+    ~CameraUniformBuffer();
+
+    void update(const Eigen::Matrix4d& view, const Eigen::Matrix4d& projection,
+                const Eigen::Vector2d& viewport);
+
+    static constexpr GLuint bindingPoint = 0;
+    static constexpr const char* blockName = "Camera";
+
+    /* Size of the block: std140 rounds the two matrices and the vec2 up to
+     * the alignment of a vec4. */
+    static constexpr GLsizeiptr blockSize = (2 * 16 + 4) * sizeof(GLfloat);
+
+private:
+    GLuint bufferID;
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef CAMERA_UNIFORM_BUFFER_H */
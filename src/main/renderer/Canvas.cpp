@@ -16,7 +16,8 @@ using namespace iphito::utils;
 
 Canvas::Canvas(unsigned int width, unsigned int height) : width{width},
     height{height}, rootLayer{new Layer()},
-    transform{Eigen::Matrix3d::Identity()} {
+    transform{Eigen::Matrix3d::Identity()}, view{Eigen::Matrix4d::Identity()},
+    projection{Eigen::Matrix4d::Identity()}, viewAABB{AABB::unbounded()} {
         
         if(!Utils::isGlfwInitialized())
             throw std::runtime_error("Please initialize GLFW."); 
@@ -38,22 +39,103 @@ unsigned int Canvas::getHeight() {
 }
 
 void Canvas::setRootLayer(std::shared_ptr<Layer> rootLayer) {
+    this->clearHover();
     this->rootLayer = rootLayer;
+    this->rootLayer->updateViewMatrix(this->view);
+    this->rootLayer->updateProjectionMatrix(this->projection);
+    this->rootLayer->updateViewportSize(this->width, this->height);
+    this->rootLayer->updateViewAABB(this->viewAABB);
 }
 
+/**
+ * Tessellates every dirty curve of the layer tree on the thread pool first,
+ * so that rendering the layers only uploads the results on the GL thread.
+ */
 void Canvas::render() {
+
+    this->curvesToTessellate.clear();
+    this->rootLayer->collectCurvesToTessellate(this->curvesToTessellate);
+
+    this->threadPool.parallelFor(this->curvesToTessellate.size(),
+                                 [this](std::size_t i) {
+        this->curvesToTessellate[i]->tessellate();
+    });
+
     glBindVertexArray(this->vertexArrayObjectID);
     this->rootLayer->render();
 }
 
 void Canvas::updateViewMatrix(const Eigen::Matrix4d& view) {
 
+    this->view = view;
     this->rootLayer->updateViewMatrix(view);
 }
 
 void Canvas::updateProjectionMatrix(const Eigen::Matrix4d& projection) {
 
+    this->projection = projection;
     this->rootLayer->updateProjectionMatrix(projection);
 }
 
+void Canvas::updateViewportSize(unsigned int width, unsigned int height) {
+
+    this->width = width;
+    this->height = height;
+    this->rootLayer->updateViewportSize(width, height);
+}
+
+/**
+ * Sets the part of the world visible in the window, outside of which the
+ * curves are only coarsely tessellated.
+ */
+void Canvas::updateViewAABB(const AABB& viewAABB) {
+
+    this->viewAABB = viewAABB;
+    this->rootLayer->updateViewAABB(viewAABB);
+}
+
+/**
+ * Finds the curve closest to a point of the world, among the ones closer than
+ * the radius.
+ */
+bool Canvas::pick(const Eigen::Vector2d& point, double radius,
+                  CurvePick& pick) {
+
+    return this->rootLayer->pick(point, radius, pick);
+}
+
+/**
+ * Highlights the curve picked at a point of the world instead of the one
+ * previously hovered. Returns whether the highlighted curve changed.
+ */
+bool Canvas::updateHover(const Eigen::Vector2d& point, double radius) {
+
+    CurvePick pick;
+    std::optional<unsigned long long> hovered;
+
+    if (this->pick(point, radius, pick)) hovered = pick.curve->getID();
+
+    if (hovered == this->hoveredCurveID) return false;
+
+    this->clearHover();
+
+    if (hovered) pick.curve->setHighlighted(true);
+
+    this->hoveredCurveID = hovered;
+    return true;
+}
+
+/**
+ * Stops highlighting the hovered curve, if it is still in the tree.
+ */
+void Canvas::clearHover() {
+
+    if (this->hoveredCurveID) {
+        Curve2D* curve = this->rootLayer->findCurve(*this->hoveredCurveID);
+        if (curve != nullptr) curve->setHighlighted(false);
+    }
+
+    this->hoveredCurveID.reset();
+}
+
 } /* namespace iphito::renderer */
@@ -9,10 +9,13 @@
 #ifndef CANVAS_H
 #define CANVAS_H
 
+#include <optional>
+#include <vector>
 #include <Eigen/Core>
 #include <GL/glew.h>
 
 #include "Layer.h"
+#include "src/main/utils/ThreadPool.h"
 
 namespace iphito::renderer {
 
@@ -29,6 +32,11 @@ public:
     void render();
     void updateViewMatrix(const Eigen::Matrix4d& view);
     void updateProjectionMatrix(const Eigen::Matrix4d& projection);
+    void updateViewportSize(unsigned int width, unsigned int height);
+    void updateViewAABB(const AABB& viewAABB);
+    bool pick(const Eigen::Vector2d& point, double radius, CurvePick& pick);
+    bool updateHover(const Eigen::Vector2d& point, double radius);
+    void clearHover();
     
 
 private:
@@ -37,6 +45,12 @@ private:
     std::shared_ptr<Layer> rootLayer; // shared or unique?
     GLuint vertexArrayObjectID;
     Eigen::Matrix3d transform;
+    Eigen::Matrix4d view;
+    Eigen::Matrix4d projection;
+    iphito::utils::ThreadPool threadPool;
+    std::vector<Curve2D*> curvesToTessellate;
+    AABB viewAABB;
+    std::optional<unsigned long long> hoveredCurveID;
 };
 
 } /* namespace iphito::renderer */
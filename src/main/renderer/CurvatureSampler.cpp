@@ -0,0 +1,86 @@
+/**
+ * @file CurvatureSampler.cpp
+ * @brief Implements a sampler deriving segment counts from the curvature
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-06
+ */
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+
+#include "CurvatureSampler.h"
+#include "WangFlattener.h"
+#include "src/main/math/Bezier.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::math;
+
+void CurvatureSampler::sample(Curve& curve, const Eigen::Matrix4d& transform,
+                              double tolerance, unsigned long long /* seed */,
+                              double a, double b,
+                              std::vector<double>& parameters,
+                              std::vector<Eigen::Vector2d>& points) {
+
+    constexpr int spans = CurvatureSampler::probeSpans;
+
+    std::array<double, spans + 1> probes;
+    for (int i = 0; i < spans; i++)
+        probes[i] = a + (b - a) * i / spans;
+    probes[spans] = b;
+
+    std::array<Eigen::Vector2d, spans + 1> probePoints;
+    curve.evaluateAt(probes, probePoints);
+
+    /* The control points in screen space, translations left out, restricted
+     * to [a, b]. */
+    const Eigen::Matrix2d linear = transform.topLeftCorner<2, 2>();
+    std::vector<Eigen::Vector2d> rest = curve.getBezierPoints();
+    for (auto& i : rest) i = linear * i;
+
+    rest = Bezier::subdivide(rest, b).first;
+    if (b > 0.0) rest = Bezier::subdivide(rest, a / b).second;
+
+    std::array<int, spans> segments;
+    std::vector<double> interior;
+
+    for (int i = 0; i < spans; i++) {
+
+        /* Splits the first span off the rest of the interval. */
+        std::vector<Eigen::Vector2d> span = rest;
+        if (i < spans - 1) {
+            std::tie(span, rest) = Bezier::subdivide(rest,
+                                                     1.0 / (spans - i));
+        }
+
+        const double h = probes[i+1] - probes[i];
+        segments[i] = WangFlattener::wangSegments(span, tolerance, 1.0,
+                CurvatureSampler::maximumSegmentsPerSpan);
+
+        for (int k = 1; k < segments[i]; k++)
+            interior.push_back(probes[i] + k * h / segments[i]);
+    }
+
+    std::vector<Eigen::Vector2d> interiorPoints(interior.size());
+    curve.evaluateAt(interior, interiorPoints);
+
+    parameters.reserve(parameters.size() + interior.size() + spans + 1);
+    points.reserve(points.size() + interior.size() + spans + 1);
+
+    for (std::size_t i = 0, j = 0; i < spans; i++) {
+        parameters.push_back(probes[i]);
+        points.push_back(probePoints[i]);
+
+        for (int k = 1; k < segments[i]; k++, j++) {
+            parameters.push_back(interior[j]);
+            points.push_back(interiorPoints[j]);
+        }
+    }
+
+    parameters.push_back(probes[spans]);
+    points.push_back(probePoints[spans]);
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,51 @@
+/**
+ * @file CurvatureSampler.h
+ * @brief Describes a sampler deriving segment counts from the curvature
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-06
+ */
+#ifndef CURVATURE_SAMPLER_H
+#define CURVATURE_SAMPLER_H
+
+#include <vector>
+#include <Eigen/Core>
+
+#include "Sampler.h"
+
+namespace iphito::renderer {
+
+/**
+ * Probes the curve at a few uniform parameters and bounds, on every probe
+ * span, the acceleration |r''| of the curve in screen space, which the
+ * curvature drives. The bound is the largest second difference of the Bézier
+ * control points of the curve restricted to the span, scaled by n (n - 1):
+ * these are the control points of the second hodograph, whose convex hull
+ * contains r''. A chord of parameter length h deviates from the curve by at
+ * most h^2 max |r''| / 8, which gives the number of uniform segments needed
+ * on the span for the tolerance up front, i.e. Wang's formula on every span.
+ * The probes are reused as samples and all the other samples are evaluated
+ * in a single batch, so no point is evaluated twice and the output only
+ * depends on the curve and the transform.
+ *
+ * The transform is assumed affine, which holds for the orthographic
+ * projections of the renderer. The count of every span is capped, past which
+ * the tolerance no longer holds.
+ */
+class CurvatureSampler : public Sampler {
+
+public:
+    using Sampler::sample;
+    void sample(iphito::math::Curve& curve, const Eigen::Matrix4d& transform,
+                double tolerance, unsigned long long seed, double a, double b,
+                std::vector<double>& parameters,
+                std::vector<Eigen::Vector2d>& points) override;
+
+private:
+    static constexpr int probeSpans = 16;
+    static constexpr int maximumSegmentsPerSpan = 256;
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef CURVATURE_SAMPLER_H */
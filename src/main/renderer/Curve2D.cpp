@@ -5,11 +5,21 @@
  * @version 0.1.0
  * @date 2018-12-10
  */
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
+#include <Eigen/Dense>
 #include "Curve2D.h"
+#include "CurveClipper.h"
+#include "Layer.h"
+#include "ShaderRegistry.h"
+#include "WangFlattener.h"
 
-#include "src/main/utils/Logger.h"
+#include "src/main/math/Bezier.h"
 #include "src/main/utils/Utils.h"
 
 namespace iphito::renderer {
@@ -18,17 +28,24 @@ using namespace iphito::math;
 using namespace iphito::utils;
 
 inline std::atomic<unsigned long long> Curve2D::nextID = 0;
-inline std::mt19937_64 Curve2D::engine = std::mt19937_64();
-inline std::uniform_real_distribution<double> Curve2D::distribution(0.0, 1.0);
+const Eigen::Vector3d Curve2D::highlightColor = Eigen::Vector3d(1.0, 0.6, 0.0);
 
 Curve2D::Curve2D(std::shared_ptr<Curve> curve, double curveWidth,
                  const Eigen::Vector3d& curveColor,
                  const Eigen::Matrix3d& transform) :
-    curve{curve}, curveWidth{curveWidth/2.0}, curveColor{curveColor}, 
-    isDirty{true}, viewMatrixUpdate{true}, projectionMatrixUpdate{true}, 
-    id{this->nextID.fetch_add(1)}, samplePoints{std::vector<Eigen::Vector2d>()},
+    curve{curve}, curveWidth{curveWidth}, isWidthInPixels{false},
+    curveColor{curveColor}, isHighlighted{false}, depth{0.0}, isDirty{true},
+    isUploadPending{false}, viewMatrixUpdate{true},
+    projectionMatrixUpdate{true},
     model{Eigen::Matrix4d::Identity()}, view{Eigen::Matrix4d::Identity()},
-    projection{Eigen::Matrix4d::Identity()} {
+    projection{Eigen::Matrix4d::Identity()},
+    viewport{Eigen::Matrix4d::Identity()}, id{this->nextID.fetch_add(1)},
+    layer{nullptr}, cameraVersion{0},
+    samplePoints{std::vector<Eigen::Vector2d>()},
+    sampler{std::make_shared<WangFlattener>()},
+    tolerance{Curve2D::defaultTolerance}, currentSlot{-1}, styleVersion{0},
+    viewAABB{AABB::unbounded()}, tessellatedRegion{AABB::unbounded()},
+    isSegmentIndexDirty{true} {
 
     if(!Utils::isGlfwInitialized())
         throw std::runtime_error("Please initialize GLFW.");
@@ -36,54 +53,389 @@ Curve2D::Curve2D(std::shared_ptr<Curve> curve, double curveWidth,
     if(!Utils::isGlewInitialized())
         throw std::runtime_error("Please initialize Glew.");
 
-    this->shader.reset(new Shader("../src/shaders/basic.vert",
-                                  "../src/shaders/basic.frag"));
-    this->shader->useProgram();
+    this->shader = ShaderRegistry::Instance()->get(
+            "stroke.vert", "overlay.frag");
+
+    auto [min, max] = Bezier::bounds(this->curve->getBezierPoints());
+    this->curveBounds = AABB(min, max);
 
-    int curveColorLocation = glGetUniformLocation(this->shader->getProgramID(),
-            "color");
-    glUniform3f(curveColorLocation, this->curveColor[0], this->curveColor[1],
-            this->curveColor[2]);
+    this->levelOfDetail.update(this->pixelScale());
+}
 
-    glGenVertexArrays(1, &this->vertexArrayObjectID);
-    glBindVertexArray(this->vertexArrayObjectID);
+/**
+ * Releases the ranges of every cached tessellation in the shared buffers.
+ */
+Curve2D::~Curve2D() {
 
-    glGenBuffers(1, &this->vertexBufferID);
-    glGenBuffers(1, &this->indexBufferID);
+    for (auto& i : this->tessellations) {
+        StrokeStorage::Instance().release(i.range);
+    }
 }
 
+/**
+ * Tessellates the curve if needed and uploads the result. Has to be called
+ * from the thread owning the GL context.
+ */
 void Curve2D::recomputeVerticesAndIndices() {
 
-    this->vertices = std::vector<GLfloat>();
-    this->indices = std::vector<GLuint>();
+    if (this->isDirty) this->tessellate();
+    if (this->isUploadPending) this->upload();
+}
+
+/**
+ * Samples the curve on the CPU only, without any GL call, so that distinct
+ * curves can be tessellated concurrently. The stroke is extruded to its width
+ * in the vertex shader, so the tessellation does not depend on the width.
+ *
+ * Only the parameter intervals which may be visible in the view, enlarged by
+ * the clipping margin, are sampled with the tolerance. The others are replaced
+ * by their chord, so the size of the tessellation does not grow with the zoom
+ * when most of the curve is off-screen.
+ */
+void Curve2D::tessellate() {
+
     this->samplePoints = std::vector<Eigen::Vector2d>();
+    this->sampleParameters = std::vector<double>();
+    this->sampleOffsets = std::vector<Eigen::Vector2d>();
 
-    std::unique_ptr<Curve> upper = this->curve->offsetBy(this->curveWidth);
-    std::unique_ptr<Curve> lower = this->curve->offsetBy(-this->curveWidth);
-    sampleCurve(0.0, 1.0);
+    const Eigen::Matrix4d transform = this->levelTransform();
+    std::vector<ParameterInterval> intervals = CurveClipper::clip(
+            this->curve->getBezierPoints(), this->clippingRegion());
 
-    Logger::Instance()->debug(std::to_string(this->samplePoints.size()));
+    for (auto& i : intervals) {
 
-    /* sampleCurve(0.0, 1.0, *upper.get()); */
-    /* sampleCurve(0.0, 1.0, *lower.get()); */
+        std::size_t offset = this->sampleParameters.size();
 
-    verticesFromSamplePoints(this->samplePoints);
-    indicesFromVertices();
+        if (i.visible) {
+            this->sampler->sample(*this->curve, transform, this->tolerance,
+                                  this->id, i.a, i.b, this->sampleParameters,
+                                  this->samplePoints);
+        }
+        else {
+            const std::array<double, 2> ends = {i.a, i.b};
+            std::array<Eigen::Vector2d, 2> endPoints;
+            this->curve->evaluateAt(ends, endPoints);
+
+            this->sampleParameters.insert(this->sampleParameters.end(),
+                                          ends.begin(), ends.end());
+            this->samplePoints.insert(this->samplePoints.end(),
+                                      endPoints.begin(), endPoints.end());
+        }
 
-    glBindVertexArray(this->vertexArrayObjectID);
+        /* Adjacent intervals share their end point. */
+        if (offset > 0 && offset < this->sampleParameters.size() &&
+            this->sampleParameters[offset] ==
+            this->sampleParameters[offset - 1]) {
 
-    glBindBuffer(GL_ARRAY_BUFFER, this->vertexBufferID);
-    glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(GLfloat),
-                 &this->vertices[0], GL_STATIC_DRAW);
+            this->sampleParameters.erase(this->sampleParameters.begin() +
+                                         offset);
+            this->samplePoints.erase(this->samplePoints.begin() + offset);
+        }
+    }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(GLuint),
-                 &this->indices[0], GL_STATIC_DRAW);
+    bool isClipped = std::any_of(intervals.begin(), intervals.end(),
+            [](const ParameterInterval& i) { return !i.visible; });
+    this->tessellatedRegion = isClipped ?
+        this->viewAABB.expandedBy(Curve2D::clippingMargin) : AABB::unbounded();
 
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
-    glEnableVertexAttribArray(0);
+    this->offsetsFromSamplePoints();
 
+    this->isSegmentIndexDirty = true;
     this->isDirty = false;
+    this->isUploadPending = true;
+}
+
+/**
+ * Stores the tessellation in the cache slot of its level, reusing the slot of
+ * the least recently used level once the cache is full. The tessellation of
+ * the slot is replaced by new ranges of the buffers shared by all the
+ * strokes. The vertices, their style and the indices are written straight to
+ * the staging buffer and copied on the GPU to these ranges.
+ */
+void Curve2D::upload() {
+
+    int slot = this->levelOfDetail.insert();
+
+    if (slot == static_cast<int>(this->tessellations.size()))
+        this->tessellations.push_back(Tessellation{});
+
+    const GLsizei sampleCount = this->samplePoints.size();
+    const GLsizei vertexCount = sampleCount < 2 ? 0 : 2 * sampleCount;
+    const GLsizei indexCount = sampleCount < 2 ? 0 : 6 * (sampleCount - 1);
+    const GLsizeiptr vertexBytes = vertexCount * StrokeStorage::vertexSize;
+    const GLsizeiptr styleBytes = vertexCount * StrokeStorage::styleSize;
+    const GLsizeiptr indexBytes = indexCount * sizeof(GLuint);
+
+    StrokeStorage& storage = StrokeStorage::Instance();
+    Tessellation& t = this->tessellations[slot];
+    storage.release(t.range);
+    t.range = storage.allocate(vertexCount, indexCount);
+    t.region = this->tessellatedRegion;
+    t.styleVersion = this->styleVersion;
+    t.samplePoints = this->samplePoints;
+    t.sampleParameters = this->sampleParameters;
+
+    if (t.range.indexCount > 0) {
+        StreamBuffer& staging = Curve2D::stagingBuffer();
+        char* memory = static_cast<char*>(staging.map(vertexBytes +
+                                                      styleBytes +
+                                                      indexBytes));
+        this->writeVertices(reinterpret_cast<GLfloat*>(memory));
+        this->writeStyle(reinterpret_cast<GLfloat*>(memory + vertexBytes),
+                         vertexCount);
+        this->writeIndices(reinterpret_cast<GLuint*>(memory + vertexBytes +
+                                                     styleBytes));
+        GLintptr offset = staging.unmap();
+
+        glBindBuffer(GL_COPY_READ_BUFFER, staging.getBufferID());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, storage.getVertexBufferID());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset,
+                            t.range.firstVertex * StrokeStorage::vertexSize,
+                            vertexBytes);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, storage.getStyleBufferID());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            offset + vertexBytes,
+                            t.range.firstVertex * StrokeStorage::styleSize,
+                            styleBytes);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, storage.getIndexBufferID());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                            offset + vertexBytes + styleBytes,
+                            t.range.firstIndex * sizeof(GLuint), indexBytes);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    this->useTessellation(slot);
+    this->isUploadPending = false;
+}
+
+/**
+ * Draws the curve on its own: its underlay, its stroke and its overlay.
+ * Layers draw the strokes of all their curves together instead.
+ */
+void Curve2D::render() {
+
+    this->prepare();
+    this->renderUnderlay();
+    this->renderStroke();
+    this->renderOverlay();
+}
+
+/**
+ * Brings the tessellation and its style up to date before drawing. Has to be
+ * called from the thread owning the GL context.
+ */
+void Curve2D::prepare() {
+
+    if (this->hasToBeRedrawn()) this->recomputeVerticesAndIndices();
+    this->updateStyle();
+}
+
+void Curve2D::renderStroke() {
+
+    this->shader->useProgram();
+    this->shader->setMatrix4("model", this->model);
+
+    const StrokeStorage::Range range = this->getStrokeRange();
+
+    glBindVertexArray(StrokeStorage::Instance().getVertexArrayID());
+    glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+            reinterpret_cast<const void*>(range.firstIndex * sizeof(GLuint)),
+            range.firstVertex);
+    glBindVertexArray(0);
+}
+
+/**
+ * Staging buffer shared by the uploads of all the curves. It lives as long as
+ * the context.
+ */
+StreamBuffer& Curve2D::stagingBuffer() {
+
+    static StreamBuffer* staging = new StreamBuffer(Curve2D::stagingCapacity);
+
+    return *staging;
+}
+
+/**
+ * Writes the style of the current tessellation again once it changed. The
+ * other cached tessellations are written when they are used again.
+ */
+void Curve2D::updateStyle() {
+
+    if (this->currentSlot == -1) return;
+
+    Tessellation& t = this->tessellations[this->currentSlot];
+    if (t.styleVersion == this->styleVersion) return;
+
+    t.styleVersion = this->styleVersion;
+    if (t.range.vertexCount == 0) return;
+
+    const GLsizeiptr styleBytes = t.range.vertexCount *
+                                  StrokeStorage::styleSize;
+
+    StreamBuffer& staging = Curve2D::stagingBuffer();
+    this->writeStyle(static_cast<GLfloat*>(staging.map(styleBytes)),
+                     t.range.vertexCount);
+    GLintptr offset = staging.unmap();
+
+    glBindBuffer(GL_COPY_READ_BUFFER, staging.getBufferID());
+    glBindBuffer(GL_COPY_WRITE_BUFFER,
+                 StrokeStorage::Instance().getStyleBufferID());
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset,
+                        t.range.firstVertex * StrokeStorage::styleSize,
+                        styleBytes);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/**
+ * The color, the width or the depth changed: the styles of the cached
+ * tessellations are written again before they are drawn.
+ */
+void Curve2D::invalidateStyle() {
+
+    this->styleVersion++;
+}
+
+void Curve2D::useTessellation(int slot) {
+
+    this->currentSlot = slot;
+}
+
+/**
+ * Whether the finely tessellated region of a slot still contains the view.
+ */
+bool Curve2D::coversView(int slot) {
+
+    return this->tessellations[slot].region.contains(this->viewAABB);
+}
+
+/**
+ * The view enlarged by the clipping margin, in the space of the curve.
+ */
+AABB Curve2D::clippingRegion() {
+
+    AABB region = this->viewAABB.expandedBy(Curve2D::clippingMargin);
+
+    if (!region.getMin().allFinite() || !region.getMax().allFinite())
+        return AABB::unbounded();
+
+    const Eigen::Matrix4d inverse = this->model.inverse();
+    const Eigen::Vector2d min = region.getMin();
+    const Eigen::Vector2d max = region.getMax();
+
+    std::vector<Eigen::Vector2d> corners;
+    for (double x : {min[0], max[0]}) {
+        for (double y : {min[1], max[1]}) {
+            Eigen::Vector4d corner = inverse * Eigen::Vector4d(x, y, 0.0, 1.0);
+            corners.push_back(corner.head<2>());
+        }
+    }
+
+    return AABB::fromPoints(corners);
+}
+
+/**
+ * Number of pixels per curve unit with the current matrices.
+ */
+double Curve2D::pixelScale() {
+
+    Eigen::Matrix4d transform = this->viewport * this->projection *
+                                this->view * this->model;
+    Eigen::Matrix2d linear = transform.topLeftCorner<2, 2>();
+
+    return std::max(linear.col(0).norm(), linear.col(1).norm());
+}
+
+/**
+ * The transform the current level is tessellated with: the linear part of the
+ * current one rescaled to the scale of the level, without translation. The
+ * tessellation of a level is thus the same whatever the exact zoom within the
+ * level and the panning.
+ */
+Eigen::Matrix4d Curve2D::levelTransform() {
+
+    Eigen::Matrix4d transform = this->viewport * this->projection *
+                                this->view * this->model;
+    Eigen::Matrix2d linear = transform.topLeftCorner<2, 2>();
+
+    Eigen::Matrix4d levelTransform = Eigen::Matrix4d::Identity();
+    double pixelScale = this->pixelScale();
+
+    /* Nothing is visible in an empty viewport: the curve is tessellated as
+     * if it was drawn at the scale of the level, without any rotation. */
+    if (!(pixelScale > 0.0) || !std::isfinite(pixelScale)) {
+        levelTransform.topLeftCorner<2, 2>() *=
+            this->levelOfDetail.getLevelScale();
+        return levelTransform;
+    }
+
+    levelTransform.topLeftCorner<2, 2>() = linear *
+        (this->levelOfDetail.getLevelScale() / pixelScale);
+
+    return levelTransform;
+}
+
+/**
+ * Follows the zoom level of the current matrices, switching to a cached
+ * tessellation when there is one and asking for a new one otherwise. The
+ * samples of a cached tessellation come back with it, so that picking finds
+ * the curve as it is drawn.
+ */
+void Curve2D::updateLevelOfDetail() {
+
+    if (!this->levelOfDetail.update(this->pixelScale())) return;
+
+    int slot = this->levelOfDetail.find();
+
+    if (slot != -1 && this->coversView(slot)) {
+        this->useTessellation(slot);
+        this->samplePoints = this->tessellations[slot].samplePoints;
+        this->sampleParameters = this->tessellations[slot].sampleParameters;
+        this->isSegmentIndexDirty = true;
+        this->isDirty = false;
+        this->isUploadPending = false;
+    }
+    else {
+        this->isDirty = true;
+    }
+}
+
+/**
+ * Whether the last tessellation or a cached one only covers a region of the
+ * world.
+ */
+bool Curve2D::isClipped() {
+
+    const AABB unbounded = AABB::unbounded();
+
+    if (!this->tessellatedRegion.contains(unbounded)) return true;
+
+    for (auto& i : this->tessellations) {
+        if (!i.region.contains(unbounded)) return true;
+    }
+
+    return false;
+}
+
+void Curve2D::invalidateTessellations() {
+
+    this->levelOfDetail.clear();
+    this->isDirty = true;
+}
+
+/**
+ * Tells the layer holding the curve that the box of the curve changed, so
+ * that only its hierarchy is rebuilt.
+ */
+void Curve2D::invalidateBounds() {
+
+    if (this->layer != nullptr) this->layer->invalidateIndex();
+}
+
+bool Curve2D::hasToBeTessellated() {
+
+    return this->isDirty;
 }
 
 unsigned long long Curve2D::getID() {
@@ -91,249 +443,417 @@ unsigned long long Curve2D::getID() {
     return this->id;
 }
 
-void Curve2D::sampleCurve(double a, double b) {
-
-    double t = 0.45 + 0.1 * Curve2D::distribution(Curve2D::engine);
-    double m = a + t * (b - a);
-
-    Eigen::Vector4d pa3D;
-    Eigen::Vector4d pb3D;
-    Eigen::Vector4d pm3D;
-    pa3D << this->curve->evaluateAt(a), 1.0, 0.0;
-    pb3D << this->curve->evaluateAt(b), 1.0, 0.0;
-    pm3D << this->curve->evaluateAt(m), 1.0, 0.0;
-
-    Eigen::Vector2d pa;
-    Eigen::Vector2d pb;
-    Eigen::Vector2d pm;
-    pa << pa3D[0], pa3D[1];
-    pb << pb3D[0], pb3D[1];
-    pm << pm3D[0], pm3D[1];
-
-    pa3D = this->projection * this->view * this->model * pa3D;
-    pb3D = this->projection * this->view * this->model * pb3D;
-    pm3D = this->projection * this->view * this->model * pm3D;
-    Eigen::Vector2d paScreen;
-    Eigen::Vector2d pbScreen;
-    Eigen::Vector2d pmScreen;
-    paScreen << pa3D[0], pa3D[1];
-    pbScreen << pb3D[0], pb3D[1];
-    pmScreen << pm3D[0], pm3D[1];
-
-
-    if(isFlat(paScreen, pbScreen, pmScreen)) {
-        if(!samplePoints.empty()) {
-            Eigen::Vector2d back = this->samplePoints.back();
-            if(!(Utils::nearlyEqual(back[0], pa[0]) && 
-                 Utils::nearlyEqual(back[1], pa[1]))) {
-
-                this->samplePoints.push_back(pa);
-                this->samplePoints.push_back(pb);
-            }
-            else {
-                this->samplePoints.push_back(pb);
-            }
-        }
-        else {
-            this->samplePoints.push_back(pa);
-            this->samplePoints.push_back(pb);
+const Eigen::Vector3d& Curve2D::getColor() {
+
+    return this->isHighlighted ? Curve2D::highlightColor : this->curveColor;
+}
+
+/**
+ * A highlighted curve is drawn with the highlight color instead of its own,
+ * e.g. while the cursor hovers it.
+ */
+void Curve2D::setHighlighted(bool isHighlighted) {
+
+    if (isHighlighted == this->isHighlighted) return;
+
+    this->isHighlighted = isHighlighted;
+    this->invalidateStyle();
+}
+
+bool Curve2D::getHighlighted() {
+
+    return this->isHighlighted;
+}
+
+/**
+ * Finds the point of the curve closest to a point of the world, if it is
+ * closer than the radius. The segments of the current tessellation within the
+ * radius, found with the hierarchy over their boxes, give a first guess which
+ * is refined on the curve itself with Newton's method. A curve which was never
+ * tessellated cannot be picked.
+ *
+ * The search runs in the space of the curve, but its distances are the ones
+ * of the world: a model matrix which does not scale uniformly moves the
+ * closest point.
+ */
+bool Curve2D::closestPoint(const Eigen::Vector2d& point, double radius,
+                           CurvePick& pick) {
+
+    if (this->samplePoints.size() < 2) return false;
+
+    this->updateSegmentIndex();
+
+    /* The radius is brought to the space of the curve with a bound of the
+     * stretching of the inverse model matrix. */
+    const Eigen::Matrix4d inverse = this->model.inverse();
+    const Eigen::Vector2d local = (inverse *
+        Eigen::Vector4d(point[0], point[1], 0.0, 1.0)).head<2>();
+    const Eigen::Matrix2d linear = inverse.topLeftCorner<2, 2>();
+    const Eigen::Vector2d margin = Eigen::Vector2d::Constant(radius *
+                                                             linear.norm());
+    const Eigen::Matrix2d forward = this->model.topLeftCorner<2, 2>();
+    const Eigen::Matrix2d metric = forward.transpose() * forward;
+
+    this->nearSegments.clear();
+    this->segmentIndex.query(AABB(local - margin, local + margin),
+                             this->nearSegments);
+
+    if (this->nearSegments.empty()) return false;
+
+    double guess = 0.0;
+    double guessDistance = std::numeric_limits<double>::infinity();
+
+    for (int i : this->nearSegments) {
+        const Eigen::Vector2d& a = this->samplePoints[i];
+        const Eigen::Vector2d& b = this->samplePoints[i + 1];
+        const Eigen::Vector2d chord = b - a;
+
+        const Eigen::Vector2d metricChord = metric * chord;
+
+        double u = chord.isZero() ? 0.0 :
+            std::clamp((local - a).dot(metricChord) / chord.dot(metricChord),
+                       0.0, 1.0);
+        const Eigen::Vector2d offset = a + u * chord - local;
+        double distance = offset.dot(metric * offset);
+
+        if (distance < guessDistance) {
+            guessDistance = distance;
+            guess = (1.0 - u) * this->sampleParameters[i] +
+                    u * this->sampleParameters[i + 1];
         }
     }
-    else{
-        sampleCurve(a, m);
-        sampleCurve(m, b);
+
+    double t = this->curve->closestParameterTo(local, guess, metric);
+    Eigen::Vector2d closest = this->curve->evaluateAt(t);
+    closest = (this->model *
+               Eigen::Vector4d(closest[0], closest[1], 0.0, 1.0)).head<2>();
+    double distance = (closest - point).norm();
+
+    if (!(distance < radius)) return false;
+
+    pick = CurvePick{this, t, distance, closest};
+    return true;
+}
+
+/**
+ * Rebuilds the hierarchy over the segments once the curve was tessellated
+ * again.
+ */
+void Curve2D::updateSegmentIndex() {
+
+    if (!this->isSegmentIndexDirty) return;
+
+    std::vector<AABB> boxes;
+    boxes.reserve(this->samplePoints.size() - 1);
+
+    for (std::size_t i = 0; i + 1 < this->samplePoints.size(); i++) {
+        const Eigen::Vector2d& a = this->samplePoints[i];
+        const Eigen::Vector2d& b = this->samplePoints[i + 1];
+        boxes.push_back(AABB(a.cwiseMin(b), a.cwiseMax(b)));
     }
+
+    this->segmentIndex.build(boxes);
+    this->isSegmentIndexDirty = false;
 }
 
-void Curve2D::sampleCurve(double a, double b, const iphito::math::Curve& curve) {
-
-    double t = 0.45 + 0.1 * Curve2D::distribution(Curve2D::engine);
-    double m = a + t * (b - a);
-
-    Eigen::Vector4d pa3D;
-    Eigen::Vector4d pb3D;
-    Eigen::Vector4d pm3D;
-    pa3D << this->curve->evaluateAt(a), 1.0, 0.0;
-    pb3D << this->curve->evaluateAt(b), 1.0, 0.0;
-    pm3D << this->curve->evaluateAt(m), 1.0, 0.0;
-
-    Eigen::Vector2d pa;
-    Eigen::Vector2d pb;
-    Eigen::Vector2d pm;
-    pa << pa3D[0], pa3D[1];
-    pb << pb3D[0], pb3D[1];
-    pm << pm3D[0], pm3D[1];
-
-    pa3D = this->projection * this->view * this->model * pa3D;
-    pb3D = this->projection * this->view * this->model * pb3D;
-    pm3D = this->projection * this->view * this->model * pm3D;
-    Eigen::Vector2d paScreen;
-    Eigen::Vector2d pbScreen;
-    Eigen::Vector2d pmScreen;
-    paScreen << pa3D[0], pa3D[1];
-    pbScreen << pb3D[0], pb3D[1];
-    pmScreen << pm3D[0], pm3D[1];
-
-
-    if(isFlat(paScreen, pbScreen, pmScreen)) {
-        if(!samplePoints.empty()) {
-            Eigen::Vector2d back = this->samplePoints.back();
-            if(!(Utils::nearlyEqual(back[0], pa[0]) && 
-                 Utils::nearlyEqual(back[1], pa[1]))) {
-
-                this->samplePoints.push_back(pa);
-                this->samplePoints.push_back(pb);
-            }
-            else {
-                this->samplePoints.push_back(pb);
-            }
-        }
-        else {
-            this->samplePoints.push_back(pa);
-            this->samplePoints.push_back(pb);
+/**
+ * The width is part of the style of the vertices, applied in the stroke
+ * shader, so changing it does not tessellate the curve again.
+ */
+void Curve2D::setCurveWidth(double width) {
+
+    if (width < 0.0)
+        throw std::domain_error("The width cannot be negative.");
+
+    this->curveWidth = width;
+    this->invalidateStyle();
+    this->invalidateBounds();
+}
+
+double Curve2D::getCurveWidth() {
+
+    return this->curveWidth;
+}
+
+/**
+ * Whether the width is measured in pixels, keeping the stroke the same on
+ * screen whatever the zoom, or in the units of the curve.
+ */
+void Curve2D::setWidthInPixels(bool isWidthInPixels) {
+
+    this->isWidthInPixels = isWidthInPixels;
+    this->invalidateStyle();
+    this->invalidateBounds();
+}
+
+bool Curve2D::getWidthInPixels() {
+
+    return this->isWidthInPixels;
+}
+
+/**
+ * The depth of the curve in normalized device coordinates, with which a layer
+ * draws its curves over the ones before them in a single pass. The nearest
+ * depth is -1.
+ */
+void Curve2D::setDepth(double depth) {
+
+    if (depth == this->depth) return;
+
+    this->depth = depth;
+    this->invalidateStyle();
+}
+
+double Curve2D::getDepth() {
+
+    return this->depth;
+}
+
+/**
+ * Box containing the stroke and the decorations of the curve, in world
+ * coordinates. The stroke reaches half its width times the miter limit away
+ * from the curve. A width in pixels is left out, since it covers another part
+ * of the world at every zoom: its reach is given by getPixelReach instead.
+ */
+AABB Curve2D::getAABB() {
+
+    double reach = this->isWidthInPixels ? 0.0 :
+                   0.5 * this->curveWidth * Curve2D::miterLimit;
+    const Eigen::Vector2d margin = Eigen::Vector2d::Constant(reach);
+    AABB box = AABB(this->curveBounds.getMin() - margin,
+                    this->curveBounds.getMax() + margin) +
+               this->decorationAABB();
+
+    const Eigen::Vector2d min = box.getMin();
+    const Eigen::Vector2d max = box.getMax();
+
+    std::vector<Eigen::Vector2d> corners;
+    for (double x : {min[0], max[0]}) {
+        for (double y : {min[1], max[1]}) {
+            Eigen::Vector4d corner = this->model *
+                                     Eigen::Vector4d(x, y, 0.0, 1.0);
+            corners.push_back(corner.head<2>());
         }
     }
-    else{
-        sampleCurve(a, m, curve);
-        sampleCurve(m, b, curve);
-    }
+
+    return AABB::fromPoints(corners);
 }
 
-bool Curve2D::isFlat(Eigen::Vector2d a, Eigen::Vector2d b, Eigen::Vector2d m) {
+/**
+ * How far in pixels the stroke reaches out of the box of the curve, when its
+ * width is in pixels.
+ */
+double Curve2D::getPixelReach() {
 
-    Eigen::Vector2d ma = a - m;
-    Eigen::Vector2d mb = b - m;
+    return this->isWidthInPixels ?
+           0.5 * this->curveWidth * Curve2D::miterLimit : 0.0;
+}
 
-    if (ma.isApprox(Eigen::Vector2d::Zero()) ||
-        mb.isApprox(Eigen::Vector2d::Zero())) {
-        return true;
-    }
+const Eigen::Matrix4d& Curve2D::getModelMatrix() {
 
-    return std::abs(ma.dot(mb) / (ma.norm() * mb.norm())) > 0.999;
-}
-
-void Curve2D::verticesFromSamplePoints(std::vector<Eigen::Vector2d>&
-        samplePoints) {
-
-    if(samplePoints.size() == 0 ) return;
-
-    Eigen::Vector2d a = samplePoints[0];
-    Eigen::Vector2d b = samplePoints[1];
-
-    Eigen::Vector2d d = b-a;
-    std::swap(d[0], d[1]);
-    d[0] *= -1;
-    d.normalize();
-    Eigen::Vector2d a1 = a + (this->curveWidth * d);
-    Eigen::Vector2d a2 = a - (this->curveWidth * d);
-    this->vertices.push_back(a1[0]);
-    this->vertices.push_back(a1[1]);
-    this->vertices.push_back(a2[0]);
-    this->vertices.push_back(a2[1]);
-
-    for (int i = 0; i < samplePoints.size() - 2; i++) {
-        Eigen::Vector2d a = samplePoints[i];
-        Eigen::Vector2d b = samplePoints[i+1];
-        Eigen::Vector2d c = samplePoints[i+2];
-
-        Eigen::Vector2d v1 = (b-a);
-        Eigen::Vector2d v2 = (c-b);
-        v1.normalize();
-        v2.normalize();
-
-        Eigen::Vector2d d1 = v1;
-        std::swap(d1[0], d1[1]);
-        d1[0] *= -1;
-        d1.normalize();
-
-        Eigen::Vector2d d2 = v2;
-        std::swap(d2[0], d2[1]);
-        d2[0] *= -1;
-        d2.normalize();
-
-        Eigen::Vector2d b1 = b + (this->curveWidth * d1);
-        Eigen::Vector2d b2 = b - (this->curveWidth * d1);
-        Eigen::Vector2d c1 = b + (this->curveWidth * d2);
-        Eigen::Vector2d c2 = b - (this->curveWidth * d2);
-
-        double det1 = v1[0]*v2[1] - v1[1]*v2[0];
-        double det2 = v1[0]*b1[1] - v1[1]*b1[0];
-        double det3 = c1[0]*v1[1] - c1[1]*v1[0];
-
-        Eigen::Vector2d i1;
-        if(det1 > 0.00001 || det1 < -0.00001)
-            i1 = c1 + (det2 + det3) / det1 * v1;
-        else i1 = b1;
-
-        det1 = v1[0]*v2[1] - v1[1]*v2[0];
-        det2 = v1[0]*b2[1] - v1[1]*b2[0];
-        det3 = c2[0]*v1[1] - c2[1]*v1[0];
-
-        Eigen::Vector2d i2;
-        if(det1 > 0.00001 || det1 < -0.00001)
-            i2 = c2 + (det2 + det3) / det1 * v1;
-        else i2 = b2;
-
-        this->vertices.push_back(i1[0]);
-        this->vertices.push_back(i1[1]);
-        this->vertices.push_back(i2[0]);
-        this->vertices.push_back(i2[1]);
-    }
+    return this->model;
+}
 
-    a = samplePoints[samplePoints.size() - 2];
-    b = samplePoints[samplePoints.size() - 1];
+/**
+ * The ranges of the tessellation to draw in the buffers shared by all the
+ * strokes.
+ */
+StrokeStorage::Range Curve2D::getStrokeRange() {
 
-    d = b-a;
-    std::swap(d[0], d[1]);
-    d[0] *= -1;
-    d.normalize();
-    Eigen::Vector2d b1 = b + (this->curveWidth * d);
-    Eigen::Vector2d b2 = b - (this->curveWidth * d);
-    this->vertices.push_back(b1[0]);
-    this->vertices.push_back(b1[1]);
-    this->vertices.push_back(b2[0]);
-    this->vertices.push_back(b2[1]);
+    if (this->currentSlot == -1) return StrokeStorage::Range{0, 0, 0, 0};
+    return this->tessellations[this->currentSlot].range;
 }
 
-void Curve2D::indicesFromVertices() {
+void Curve2D::setSampler(std::shared_ptr<Sampler> sampler) {
 
-    int size = this->vertices.size()/4;
+    this->sampler = sampler;
+    this->invalidateTessellations();
+}
 
-    for (int i = 0, j = 0; j < size - 1; i += 2, j++) {
-        this->indices.push_back(i);
-        this->indices.push_back(i+1);
-        this->indices.push_back(i+2);
+void Curve2D::setTolerance(double tolerance) {
+
+    if (!(tolerance > 0.0) || !std::isfinite(tolerance))
+        throw std::domain_error("The tolerance has to be positive and "
+                                "finite.");
+
+    this->tolerance = tolerance;
+    this->invalidateTessellations();
+}
+
+double Curve2D::getTolerance() {
+
+    return this->tolerance;
+}
+
+/**
+ * The zoom level the curve is currently tessellated for.
+ */
+int Curve2D::getLevel() {
+
+    return this->levelOfDetail.getLevel();
+}
+
+/**
+ * Computes the offset of every sample point to the left side of the stroke
+ * for a unit width: the exact normal of the curve at its parameter scaled by
+ * the miter factor of the joint, so that the stroke keeps its width along the
+ * neighbouring chords. Where the derivative vanishes (cusps, degenerate
+ * control points) the normal of the neighbouring chord is used instead.
+ */
+void Curve2D::offsetsFromSamplePoints() {
+
+    const std::vector<Eigen::Vector2d>& samplePoints = this->samplePoints;
+
+    if(samplePoints.size() < 2) return;
+
+    std::vector<Eigen::Vector2d> derivatives(this->sampleParameters.size());
+    this->curve->derivativeAt(this->sampleParameters, derivatives);
+
+    this->sampleOffsets.reserve(samplePoints.size());
+
+    const int size = samplePoints.size();
+
+    for (int i = 0; i < size; i++) {
+
+        int previous = i > 0 ? i - 1 : i;
+        int next = i < size - 1 ? i + 1 : i;
+        Eigen::Vector2d d = derivatives[i];
+
+        if (d.isZero())
+            d = samplePoints[next] - samplePoints[previous];
+
+        Eigen::Vector2d normal(-d[1], d[0]);
+        normal.normalize();
+
+        /* The offset reaches the chords at half the width when its length
+         * is the inverse of the cosine to their normals. */
+        double cosine = 1.0;
+        for (int j : {previous, next}) {
+            Eigen::Vector2d chord = samplePoints[std::max(i, j)] -
+                                    samplePoints[std::min(i, j)];
+            if (chord.isZero()) continue;
+            Eigen::Vector2d chordNormal(-chord[1], chord[0]);
+            cosine = std::min(cosine, normal.dot(chordNormal.normalized()));
+        }
+
+        this->sampleOffsets.push_back(normal /
+                std::max(cosine, 1.0 / Curve2D::miterLimit));
+    }
+}
+
+/**
+ * Writes two vertices per sample point, one on each side of the curve. Both
+ * hold the point and its offset to their side.
+ */
+void Curve2D::writeVertices(GLfloat* vertices) {
 
-        this->indices.push_back(i+1);
-        this->indices.push_back(i+3);
-        this->indices.push_back(i+2);
+    int size = this->samplePoints.size();
+
+    for (int i = 0; i < size; i++) {
+        for (double side : {1.0, -1.0}) {
+            *vertices++ = this->samplePoints[i][0];
+            *vertices++ = this->samplePoints[i][1];
+            *vertices++ = side * this->sampleOffsets[i][0];
+            *vertices++ = side * this->sampleOffsets[i][1];
+        }
+    }
+}
+
+/**
+ * Writes the style of the stroke for every vertex: its color, its width,
+ * whether the width is in pixels and its depth.
+ */
+void Curve2D::writeStyle(GLfloat* styles, GLsizei vertexCount) {
+
+    const Eigen::Vector3d& color = this->getColor();
+
+    for (GLsizei i = 0; i < vertexCount; i++) {
+        *styles++ = color[0];
+        *styles++ = color[1];
+        *styles++ = color[2];
+        *styles++ = this->curveWidth;
+        *styles++ = this->isWidthInPixels ? 1.0f : 0.0f;
+        *styles++ = this->depth;
     }
 }
 
+void Curve2D::writeIndices(GLuint* indices) {
+
+    int size = this->samplePoints.size();
 
-void Curve2D::updateSamplePoints(Eigen::Matrix3d& transform) {
+    for (int i = 0, j = 0; j < size - 1; i += 2, j++) {
+        *indices++ = i;
+        *indices++ = i+1;
+        *indices++ = i+2;
 
-    for (int i = 0; i < this->samplePoints.size(); i++) {
-        Eigen::Vector2d originalPoint = this->samplePoints[i];
+        *indices++ = i+1;
+        *indices++ = i+3;
+        *indices++ = i+2;
     }
 }
 
+/**
+ * The intervals skipped by a clipped tessellation were found for the previous
+ * position of the curve in the world, and may now be visible: the clipped
+ * tessellations are dropped once the curve moves.
+ */
 void Curve2D::updateModelMatrix(const Eigen::Matrix4d& model) {
-    
+
+    bool isMoved = model != this->model;
+
     this->model = model;
+    this->invalidateBounds();
+    this->updateLevelOfDetail();
+
+    if (isMoved && this->isClipped()) this->invalidateTessellations();
 }
 
 void Curve2D::updateViewMatrix(const Eigen::Matrix4d& view) {
     
     this->view = view;
     this->viewMatrixUpdate = true;
+    this->updateLevelOfDetail();
 }
 
 void Curve2D::updateProjectionMatrix(const Eigen::Matrix4d& projection) {
 
     this->projection = projection;
     this->projectionMatrixUpdate = true;
-    this->isDirty = true;
+    this->updateLevelOfDetail();
+}
+
+/**
+ * Maps the normalized device coordinates to pixels, so that the samplers can
+ * express their tolerance in pixels.
+ */
+void Curve2D::updateViewportSize(int width, int height) {
+
+    /* A minimized window has an empty framebuffer, on which nothing is
+     * drawn: the previous size is kept. */
+    if (width <= 0 || height <= 0) return;
+
+    this->viewport = Eigen::Matrix4d::Identity();
+    this->viewport(0, 0) = width / 2.0;
+    this->viewport(1, 1) = height / 2.0;
+    this->updateLevelOfDetail();
+}
+
+/**
+ * The view changed: the current tessellation is redone once the view leaves
+ * the region it was tessellated finely for. A tessellation waiting for its
+ * upload is the current one already.
+ */
+void Curve2D::updateViewAABB(const AABB& viewAABB) {
+
+    this->viewAABB = viewAABB;
+
+    if (this->isUploadPending) {
+        if (!this->tessellatedRegion.contains(this->viewAABB))
+            this->isDirty = true;
+    }
+    else if (this->currentSlot != -1 && !this->coversView(this->currentSlot)) {
+        this->isDirty = true;
+    }
 }
 
 } /* namespace iphito::renderer */
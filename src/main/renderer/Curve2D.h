@@ -10,16 +10,32 @@
 
 #include <atomic>
 #include <memory>
-#include <random>
 #include <vector>
 #include <Eigen/Core>
 #include <GL/glew.h>
 
 #include "src/main/math/Curve.h"
+#include "AABB.h"
+#include "BoundingVolumeHierarchy.h"
+#include "LevelOfDetail.h"
+#include "Sampler.h"
 #include "Shader.h"
+#include "StreamBuffer.h"
+#include "StrokeStorage.h"
 
 namespace iphito::renderer {
 
+class Curve2D;
+class Layer;
+
+/* The point of a curve found by picking, in world coordinates. */
+struct CurvePick {
+    Curve2D* curve;
+    double parameter;
+    double distance;
+    Eigen::Vector2d point;
+};
+
 class Curve2D {
 
 public:
@@ -29,55 +45,149 @@ public:
             const Eigen::Vector3d& curveColor = Eigen::Vector3d(0.0, 0.0, 0.0),
             const Eigen::Matrix3d& transform = Eigen::Matrix3d::Identity());
     void recomputeVerticesAndIndices();
+    void tessellate();
+    void upload();
+    bool hasToBeTessellated();
     unsigned long long getID();
+    const Eigen::Vector3d& getColor();
+    void setHighlighted(bool isHighlighted);
+    bool getHighlighted();
+    bool closestPoint(const Eigen::Vector2d& point, double radius,
+                      CurvePick& pick);
+    void setCurveWidth(double width);
+    double getCurveWidth();
+    void setWidthInPixels(bool isWidthInPixels);
+    bool getWidthInPixels();
+    void setDepth(double depth);
+    double getDepth();
+    const Eigen::Matrix4d& getModelMatrix();
+    AABB getAABB();
+    double getPixelReach();
+    StrokeStorage::Range getStrokeRange();
+    void setSampler(std::shared_ptr<Sampler> sampler);
+    void setTolerance(double tolerance);
+    double getTolerance();
+    int getLevel();
     void updateModelMatrix(const Eigen::Matrix4d& model);
     void updateViewMatrix(const Eigen::Matrix4d& view);
     void updateProjectionMatrix(const Eigen::Matrix4d& projection);
-    
+    void updateViewportSize(int width, int height);
+    void updateViewAABB(const AABB& viewAABB);
+
+    /* Maximal distance in pixels between the curve and its tessellation. */
+    static constexpr double defaultTolerance = 0.25;
+
+    /* Fraction of the view size tessellated finely around the view. */
+    static constexpr double clippingMargin = 0.5;
+
+    /* Longest offset of a joint, in half widths. */
+    static constexpr double miterLimit = 4.0;
+
+    /* Initial size in bytes of the staging buffer of the uploads. */
+    static constexpr GLsizeiptr stagingCapacity = 1 << 20;
+
+    /* Color of the stroke of a highlighted curve. */
+    static const Eigen::Vector3d highlightColor;
 
     virtual ~Curve2D() = 0;
-    virtual void render() = 0;
     virtual bool hasToBeRedrawn() = 0;
+
+    void render();
+    void prepare();
+    virtual void renderUnderlay() {}
+    void renderStroke();
+    virtual void renderOverlay() {}
+    virtual AABB decorationAABB() { return AABB::empty(); }
     
 
 protected:
 
     std::shared_ptr<iphito::math::Curve> curve;
 
-    std::unique_ptr<Shader> shader;
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-    GLuint vertexArrayObjectID;
-    GLuint vertexBufferID;
-    GLuint indexBufferID;
+    std::shared_ptr<Shader> shader;
 
     double curveWidth;
+    bool isWidthInPixels;
     Eigen::Vector3d curveColor;
+    bool isHighlighted;
+
+    /* Depth of the stroke and of the decorations in normalized device
+     * coordinates, ordering the curves of a layer. */
+    double depth;
 
     bool isDirty;
+    bool isUploadPending;
     bool viewMatrixUpdate;
     bool projectionMatrixUpdate;
 
     Eigen::Matrix4d model;
     Eigen::Matrix4d view;
     Eigen::Matrix4d projection;
+    Eigen::Matrix4d viewport;
 
 private:
+    friend class Layer;
+
+    /* A tessellation in the buffers shared by all the strokes. */
+    struct Tessellation {
+        StrokeStorage::Range range;
+        AABB region;
+
+        /* Version of the style the range was written with. */
+        unsigned long long styleVersion;
+
+        /* Picked on once the tessellation is drawn again. */
+        std::vector<Eigen::Vector2d> samplePoints;
+        std::vector<double> sampleParameters;
+    };
+
     static std::atomic<unsigned long long> nextID;
     unsigned long long id;
-    static std::mt19937_64 engine;
-    static std::uniform_real_distribution<double> distribution;
-    std::vector<Eigen::Vector2d> samplePoints;
 
-    void sampleCurve(double a, double b);
-    void sampleCurve(double a, double b, const iphito::math::Curve& curve);
-    bool isFlat(Eigen::Vector2d a, Eigen::Vector2d b, Eigen::Vector2d m);
-    void verticesFromSamplePoints(std::vector<Eigen::Vector2d>& samplePoints);
-    void indicesFromVertices();
-    void updateSamplePoints(Eigen::Matrix3d& transform);
-};
+    /* The layer holding the curve, told when the box of the curve changes. */
+    Layer* layer;
+
+    /* Version of the camera of the layer the curve was last given. */
+    unsigned long long cameraVersion;
 
-inline Curve2D::~Curve2D() {}
+    std::vector<Eigen::Vector2d> samplePoints;
+    std::vector<double> sampleParameters;
+    std::vector<Eigen::Vector2d> sampleOffsets;
+    std::shared_ptr<Sampler> sampler;
+    double tolerance;
+    LevelOfDetail levelOfDetail;
+    std::vector<Tessellation> tessellations;
+    int currentSlot;
+    unsigned long long styleVersion;
+    AABB viewAABB;
+    AABB tessellatedRegion;
+
+    /* Bounds of the curve itself, in the space of the curve. */
+    AABB curveBounds;
+
+    /* Hierarchy over the segments between the sample points, for picking. */
+    BoundingVolumeHierarchy segmentIndex;
+    bool isSegmentIndexDirty;
+    std::vector<int> nearSegments;
+
+    void offsetsFromSamplePoints();
+    void writeVertices(GLfloat* vertices);
+    void writeIndices(GLuint* indices);
+    void writeStyle(GLfloat* styles, GLsizei vertexCount);
+    void updateStyle();
+    void invalidateStyle();
+    void useTessellation(int slot);
+    static StreamBuffer& stagingBuffer();
+    bool coversView(int slot);
+    AABB clippingRegion();
+    double pixelScale();
+    Eigen::Matrix4d levelTransform();
+    void updateLevelOfDetail();
+    bool isClipped();
+    void invalidateTessellations();
+    void invalidateBounds();
+    void updateSegmentIndex();
+};
 
 } /* namespace iphito::renderer */
 
@@ -5,6 +5,8 @@
  * @version 1.0
  * @date 2020-06-13
  */
+#include <cmath>
+
 #include "Curve2DFactory.h"
 
 #include "Bezier2D.h"
@@ -22,7 +24,7 @@ using namespace iphito::parser;
 using namespace iphito::utils;
 
 Curve2DFactory::Curve2DFactory(std::shared_ptr<ASTNode> rootNode) :
-    rootNode{rootNode} {
+    rootNode{rootNode}, tolerance{Curve2D::defaultTolerance} {
 }
 
 void Curve2DFactory::setCurveColor(const Eigen::Vector3d& curveColor) {
@@ -78,6 +80,20 @@ void Curve2DFactory::setCurveWidth(double width) {
     this->curveWidth = width;
 }
 
+void Curve2DFactory::setSampler(std::shared_ptr<Sampler> sampler) {
+
+    this->sampler = sampler;
+}
+
+void Curve2DFactory::setTolerance(double tolerance) {
+
+    if (!(tolerance > 0.0) || !std::isfinite(tolerance)) {
+        Logger::Instance()->critical("cannot set a non positive tolerance");
+        return;
+    }
+    this->tolerance = tolerance;
+}
+
 std::unique_ptr<Layer> Curve2DFactory::getRootLayer() {
 
     std::unique_ptr<Layer> rootLayer(new Layer());
@@ -93,6 +109,8 @@ std::unique_ptr<Layer> Curve2DFactory::getRootLayer() {
                                 this->curveWidth, this->curveColor,
                                 this->controlPointsColor,
                                 this->controlPointsColor));
+                    if (this->sampler) bezier2D->setSampler(this->sampler);
+                    bezier2D->setTolerance(this->tolerance);
                     rootLayer->addCurve(bezier2D);
                 }
                 break;
@@ -102,6 +120,8 @@ std::unique_ptr<Layer> Curve2DFactory::getRootLayer() {
                     std::unique_ptr<Curve2D> hermite32D(new Hermite32D(
                                 hermite3, this->curveWidth, this->curveColor,
                                 this->tangentColor, this->controlPointsColor));
+                    if (this->sampler) hermite32D->setSampler(this->sampler);
+                    hermite32D->setTolerance(this->tolerance);
                     rootLayer->addCurve(hermite32D);
                 }
                 break;
@@ -112,6 +132,8 @@ std::unique_ptr<Layer> Curve2DFactory::getRootLayer() {
                                 hermite5, this->curveWidth, this->curveColor,
                                 this->tangentColor, this->secondDerivativeColor,
                                 this->controlPointsColor));
+                    if (this->sampler) hermite52D->setSampler(this->sampler);
+                    hermite52D->setTolerance(this->tolerance);
                     rootLayer->addCurve(hermite52D);
                 }
                 break;
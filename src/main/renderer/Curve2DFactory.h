@@ -13,6 +13,7 @@
 
 #include "src/main/cli/ASTNode.h"
 #include "Layer.h"
+#include "Sampler.h"
 
 namespace iphito::renderer {
 
@@ -26,6 +27,8 @@ public:
     void setControlPointsColor(const Eigen::Vector3d& controlPointsColor);
     void setSecondDerivativeColor(const Eigen::Vector3d& secondDerivativeColor);
     void setCurveWidth(double width);
+    void setSampler(std::shared_ptr<Sampler> sampler);
+    void setTolerance(double tolerance);
 
     std::unique_ptr<Layer> getRootLayer();
 
@@ -37,6 +40,8 @@ private:
     Eigen::Vector3d controlPointsColor;
     Eigen::Vector3d secondDerivativeColor;
     double curveWidth;
+    std::shared_ptr<Sampler> sampler;
+    double tolerance;
 };
 
 } /* namespace iphito::renderer */
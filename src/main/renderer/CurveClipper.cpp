@@ -0,0 +1,64 @@
+/**
+ * @file CurveClipper.cpp
+ * @brief Implements the splitting of a curve into visible and hidden
+ * parameter intervals
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-27
+ */
+#include "CurveClipper.h"
+#include "src/main/math/Bezier.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::math;
+
+/**
+ * @return the intervals covering [0, 1] in increasing order, adjacent
+ * intervals always differing in visibility.
+ */
+std::vector<ParameterInterval> CurveClipper::clip(
+        const std::vector<Eigen::Vector2d>& bezierPoints, const AABB& region) {
+
+    std::vector<ParameterInterval> intervals;
+
+    if (static_cast<int>(bezierPoints.size()) - 1 >
+        CurveClipper::maximumDegree)
+        CurveClipper::append(intervals, 0.0, 1.0, true);
+    else
+        CurveClipper::clip(bezierPoints, region, 0.0, 1.0, 0, intervals);
+
+    return intervals;
+}
+
+void CurveClipper::clip(const std::vector<Eigen::Vector2d>& bezierPoints,
+                        const AABB& region, double a, double b, int depth,
+                        std::vector<ParameterInterval>& intervals) {
+
+    AABB bounds = AABB::fromPoints(bezierPoints);
+
+    if (!region.intersects(bounds)) {
+        CurveClipper::append(intervals, a, b, false);
+    }
+    else if (region.contains(bounds) || depth == CurveClipper::maximumDepth) {
+        CurveClipper::append(intervals, a, b, true);
+    }
+    else {
+        auto [left, right] = Bezier::subdivide(bezierPoints, 0.5);
+        double m = 0.5 * (a + b);
+
+        CurveClipper::clip(left, region, a, m, depth + 1, intervals);
+        CurveClipper::clip(right, region, m, b, depth + 1, intervals);
+    }
+}
+
+void CurveClipper::append(std::vector<ParameterInterval>& intervals,
+                          double a, double b, bool visible) {
+
+    if (!intervals.empty() && intervals.back().visible == visible)
+        intervals.back().b = b;
+    else
+        intervals.push_back({a, b, visible});
+}
+
+} /* namespace iphito::renderer */
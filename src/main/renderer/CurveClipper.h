@@ -0,0 +1,57 @@
+/**
+ * @file CurveClipper.h
+ * @brief Describes the splitting of a curve into visible and hidden parameter
+ * intervals
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-27
+ */
+#ifndef CURVE_CLIPPER_H
+#define CURVE_CLIPPER_H
+
+#include <vector>
+#include <Eigen/Core>
+
+#include "AABB.h"
+
+namespace iphito::renderer {
+
+struct ParameterInterval {
+    double a;
+    double b;
+    bool visible;
+};
+
+/**
+ * Splits the parameter range [0, 1] of a Bézier curve into intervals that
+ * may intersect a region and intervals that certainly do not. A Bézier curve
+ * lies within the convex hull of its control points, hence within their
+ * bounding box: the curve is recursively subdivided with de Casteljau's
+ * algorithm until the box of a piece is either disjoint from the region or
+ * contained in it. The depth of the recursion is bounded, so the number of
+ * intervals is too, however small the region.
+ *
+ * Curves of very high degree are not clipped, subdividing them being more
+ * expensive than sampling them.
+ */
+class CurveClipper {
+
+public:
+    static std::vector<ParameterInterval> clip(
+            const std::vector<Eigen::Vector2d>& bezierPoints,
+            const AABB& region);
+
+    static constexpr int maximumDepth = 16;
+    static constexpr int maximumDegree = 64;
+
+private:
+    static void clip(const std::vector<Eigen::Vector2d>& bezierPoints,
+                     const AABB& region, double a, double b, int depth,
+                     std::vector<ParameterInterval>& intervals);
+    static void append(std::vector<ParameterInterval>& intervals, double a,
+                       double b, bool visible);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef CURVE_CLIPPER_H */
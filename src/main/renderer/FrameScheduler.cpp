@@ -0,0 +1,133 @@
+/**
+ * @file FrameScheduler.cpp
+ * @brief Implements when the window has to draw a frame
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-08
+ */
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "FrameScheduler.h"
+
+#include "src/main/utils/Logger.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::utils;
+
+FrameScheduler::FrameScheduler(bool isContinuous, double reportInterval) :
+    continuous{isContinuous}, isDirty{true}, reportInterval{reportInterval},
+    previousFrame{-1.0} {
+
+    if (reportInterval <= 0.0)
+        throw std::domain_error("The report interval has to be positive.");
+
+    this->resetStatistics(0.0);
+}
+
+/**
+ * Something changed on screen: the next iteration draws a frame.
+ */
+void FrameScheduler::requestFrame() {
+
+    this->isDirty = true;
+}
+
+bool FrameScheduler::isFrameRequested() {
+
+    return this->continuous || this->isDirty;
+}
+
+/**
+ * A frame was drawn at the given time, in seconds. The time between two
+ * frames is only measured in continuous mode, since on demand it mostly is
+ * the time spent waiting for events.
+ */
+void FrameScheduler::frameRendered(double time) {
+
+    this->isDirty = false;
+
+    if (!this->continuous) return;
+
+    if (this->previousFrame < 0.0) {
+        this->previousFrame = time;
+        this->resetStatistics(time);
+        return;
+    }
+
+    double frameTime = time - this->previousFrame;
+    this->previousFrame = time;
+
+    this->frameCount++;
+    this->totalFrameTime += frameTime;
+    this->minimumFrameTime = std::min(this->minimumFrameTime, frameTime);
+    this->maximumFrameTime = std::max(this->maximumFrameTime, frameTime);
+
+    if (time - this->reportStart >= this->reportInterval) {
+        this->report();
+        this->resetStatistics(time);
+    }
+}
+
+bool FrameScheduler::isContinuous() {
+
+    return this->continuous;
+}
+
+void FrameScheduler::setContinuous(bool isContinuous) {
+
+    this->continuous = isContinuous;
+    this->previousFrame = -1.0;
+    this->isDirty = true;
+}
+
+/**
+ * Number of frame times measured since the last report.
+ */
+int FrameScheduler::getFrameCount() {
+
+    return this->frameCount;
+}
+
+double FrameScheduler::getMeanFrameTime() {
+
+    if (this->frameCount == 0) return 0.0;
+    return this->totalFrameTime / this->frameCount;
+}
+
+double FrameScheduler::getMinimumFrameTime() {
+
+    if (this->frameCount == 0) return 0.0;
+    return this->minimumFrameTime;
+}
+
+double FrameScheduler::getMaximumFrameTime() {
+
+    return this->maximumFrameTime;
+}
+
+void FrameScheduler::report() {
+
+    std::stringstream message;
+    message << this->frameCount << " frames, ";
+    message << "frame time (ms): ";
+    message << "mean " << 1000.0 * this->getMeanFrameTime() << ", ";
+    message << "min " << 1000.0 * this->getMinimumFrameTime() << ", ";
+    message << "max " << 1000.0 * this->getMaximumFrameTime();
+
+    Logger::Instance()->info(message.str());
+}
+
+void FrameScheduler::resetStatistics(double time) {
+
+    this->reportStart = time;
+    this->frameCount = 0;
+    this->totalFrameTime = 0.0;
+    this->minimumFrameTime = std::numeric_limits<double>::infinity();
+    this->maximumFrameTime = 0.0;
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,58 @@
+/**
+ * @file FrameScheduler.h
+ * @brief Describes when the window has to draw a frame
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-08
+ */
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+namespace iphito::renderer {
+
+/**
+ * Decides whether the next iteration of the render loop draws a frame or
+ * sleeps until an event arrives.
+ *
+ * On demand, a frame is only drawn once something requested it, and all the
+ * events which arrived meanwhile are handled together before it, so a drag
+ * updates the camera at most once per frame. In continuous mode, every
+ * iteration draws a frame, and the frame times are logged at a fixed
+ * interval.
+ */
+class FrameScheduler {
+
+public:
+    FrameScheduler(bool isContinuous = false, double reportInterval = 1.0);
+
+    void requestFrame();
+    bool isFrameRequested();
+    void frameRendered(double time);
+    bool isContinuous();
+    void setContinuous(bool isContinuous);
+
+    int getFrameCount();
+    double getMeanFrameTime();
+    double getMinimumFrameTime();
+    double getMaximumFrameTime();
+
+private:
+    bool continuous;
+    bool isDirty;
+    double reportInterval;
+
+    /* Frame times since the last report, in seconds. */
+    double previousFrame;
+    double reportStart;
+    int frameCount;
+    double totalFrameTime;
+    double minimumFrameTime;
+    double maximumFrameTime;
+
+    void report();
+    void resetStatistics(double time);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef FRAME_SCHEDULER_H */
@@ -1,5 +1,6 @@
 #include <iostream>
 #include "Grid.h"
+#include "ShaderRegistry.h"
 
 #include "src/main/utils/Utils.h"
 #include "src/main/utils/Logger.h"
@@ -8,10 +9,11 @@ namespace iphito::renderer {
 
 using namespace iphito::utils;
 
-Grid::Grid(const Eigen::Vector3d& color) : color{color},
+Grid::Grid(const Eigen::Vector3d& color, Mode mode) : color{color}, mode{mode},
     model{Eigen::Matrix4d::Identity()}, view{Eigen::Matrix4d::Identity()},
     projection{Eigen::Matrix4d::Identity()},
-    viewAabb{AABB(Eigen::Vector2d(), Eigen::Vector2d())} {
+    viewAabb{AABB(Eigen::Vector2d(), Eigen::Vector2d())}, vertexCount{0},
+    quadBufferID{0} {
 
     if(!Utils::isGlfwInitialized())
         throw std::runtime_error("Please initialize GLFW.");
@@ -19,21 +21,18 @@ Grid::Grid(const Eigen::Vector3d& color) : color{color},
     if(!Utils::isGlewInitialized())
         throw std::runtime_error("Please initialize Glew.");
 
-    this->shader.reset(new Shader("../src/shaders/basic.vert",
-                                  "../src/shaders/basic.frag"));
-
-    glUseProgram(this->shader->getProgramID());
-
-    int colorLocation = glGetUniformLocation(this->shader->getProgramID(),
-                                             "color");
-    glUniform3f(colorLocation, this->color[0], this->color[1],
-            this->color[2]);
-
     glGenVertexArrays(1, &this->vertexArrayObjectID);
-    glBindVertexArray(this->vertexArrayObjectID);
 
-    glGenBuffers(1, &this->vertexBufferID);
-    glGenBuffers(1, &this->indexBufferID);
+    if (this->mode == Mode::Procedural) {
+        this->shader = ShaderRegistry::Instance()->get(
+                "grid.vert", "grid.frag");
+        this->initializeQuad();
+        return;
+    }
+
+    this->shader = ShaderRegistry::Instance()->get(
+            "basic.vert", "basic.frag");
+    this->vertexStream.reset(new StreamBuffer(Grid::streamCapacity));
 
     Eigen::Vector2d min = Eigen::Vector2d(-2, -2);
     Eigen::Vector2d max = Eigen::Vector2d(2, 2);
@@ -43,13 +42,22 @@ Grid::Grid(const Eigen::Vector3d& color) : color{color},
 }
 void Grid::render() {
 
+    if (this->mode == Mode::Procedural) {
+        this->shader->useProgram();
+        this->shader->setVector3("color", this->color);
+
+        glBindVertexArray(this->vertexArrayObjectID);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glBindVertexArray(0);
+        return;
+    }
+
     this->shader->useProgram();
     this->shader->setMatrix4("model", this->model);
-    this->shader->setMatrix4("view", this->view);
-    this->shader->setMatrix4("projection", this->projection);
+    this->shader->setVector3("color", this->color);
 
     glBindVertexArray(this->vertexArrayObjectID);
-    glDrawElements(GL_LINES, this->indices.size(), GL_UNSIGNED_INT, NULL);
+    glDrawArrays(GL_LINES, 0, this->vertexCount);
     glBindVertexArray(0);
 }
 
@@ -67,12 +75,34 @@ void Grid::updateProjectionMatrix(const Eigen::Matrix4d& projection) {
 
 void Grid::setViewAABB(const AABB& aabb) {
     this->viewAabb = aabb;
-    recomputeGrid();
+    if (this->mode == Mode::Lines) recomputeGrid();
+}
+
+/**
+ * The quad covers the viewport whatever the camera, the lines being placed by
+ * the shaders.
+ */
+void Grid::initializeQuad() {
+
+    const GLfloat corners[] = {-1.0f, -1.0f, 1.0f, -1.0f,
+                               -1.0f,  1.0f, 1.0f,  1.0f};
+
+    glBindVertexArray(this->vertexArrayObjectID);
+
+    glGenBuffers(1, &this->quadBufferID);
+    glBindBuffer(GL_ARRAY_BUFFER, this->quadBufferID);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
 }
 
+/**
+ * The lines are written straight to the next range of the stream buffer, the
+ * previous range being left to the draws still reading it.
+ */
 void Grid::recomputeGrid() {
-    this->vertices = std::vector<GLfloat>();
-    this->indices = std::vector<GLuint>();
 
     Eigen::Vector2d min = this->viewAabb.getMin();
     Eigen::Vector2d max = this->viewAabb.getMax();
@@ -88,37 +118,40 @@ void Grid::recomputeGrid() {
     double maxDelta = std::max(deltaX, deltaY);
 
     double startX = (floor(min[0] / maxDelta) - 1) * maxDelta;
+    double startY = (floor(min[1] / maxDelta) - 1 ) * maxDelta;
+
+    int lineCount = 0;
+    for (double i = startX; i <= max[0]; i += maxDelta) lineCount++;
+    for (double i = startY; i <= max[1]; i += maxDelta) lineCount++;
+
+    this->vertexCount = 2 * lineCount;
+    if (this->vertexCount == 0) return;
+
+    GLfloat* vertices = static_cast<GLfloat*>(this->vertexStream->map(
+                2 * this->vertexCount * sizeof(GLfloat)));
+
     for (double i = startX; i <= max[0]; i += maxDelta) {
-        this->vertices.push_back(i);
-        this->vertices.push_back(max[1]);
-        this->vertices.push_back(i);
-        this->vertices.push_back(min[1]);
+        *vertices++ = i;
+        *vertices++ = max[1];
+        *vertices++ = i;
+        *vertices++ = min[1];
     }
 
-    double startY = (floor(min[1] / maxDelta) - 1 ) * maxDelta;
     for (double i = startY; i <= max[1]; i += maxDelta) {
-        this->vertices.push_back(min[0]);
-        this->vertices.push_back(i);
-        this->vertices.push_back(max[0]);
-        this->vertices.push_back(i);
+        *vertices++ = min[0];
+        *vertices++ = i;
+        *vertices++ = max[0];
+        *vertices++ = i;
     }
 
-    for (int i = 0; i < this->vertices.size()/2; i++) {
-        this->indices.push_back(i);
-    }
+    GLintptr offset = this->vertexStream->unmap();
 
     glBindVertexArray(this->vertexArrayObjectID);
-
-    glBindBuffer(GL_ARRAY_BUFFER, this->vertexBufferID);
-    glBufferData(GL_ARRAY_BUFFER, this->vertices.size() * sizeof(GLfloat),
-                 &this->vertices[0], GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->indices.size() * sizeof(GLuint),
-                 &this->indices[0], GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, NULL);
+    glBindBuffer(GL_ARRAY_BUFFER, this->vertexStream->getBufferID());
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0,
+                          reinterpret_cast<const void*>(offset));
     glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
 }
 
 } /* namespace iphito::renderer */
@@ -9,13 +9,22 @@
 
 #include "AABB.h"
 #include "Shader.h"
+#include "StreamBuffer.h"
 
 namespace iphito::renderer {
 
+/**
+ * Lines every power of ten fitting about ten times in the view. They are
+ * either streamed as geometry whenever the view changes, or computed for
+ * every pixel of one quad covering the viewport, from the camera only, in
+ * which case moving the view costs no work on the CPU.
+ */
 class Grid {
 
 public:
-    Grid(const Eigen::Vector3d& color);
+    enum class Mode { Lines, Procedural };
+
+    Grid(const Eigen::Vector3d& color, Mode mode = Mode::Lines);
     /* ~Grid(); */
     
     void render();
@@ -26,21 +35,24 @@ public:
 
 private:
     Eigen::Vector3d color;
+    Mode mode;
     Eigen::Matrix4d model;
     Eigen::Matrix4d view;
     Eigen::Matrix4d projection;
 
     AABB viewAabb;
 
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-
-    std::unique_ptr<Shader> shader;
+    std::shared_ptr<Shader> shader;
     GLuint vertexArrayObjectID;
-    GLuint vertexBufferID;
-    GLuint indexBufferID;
+    std::unique_ptr<StreamBuffer> vertexStream;
+    GLsizei vertexCount;
+    GLuint quadBufferID;
+
+    /* Initial size in bytes of the buffer the lines are streamed to. */
+    static constexpr GLsizeiptr streamCapacity = 1 << 16;
 
     void recomputeGrid();
+    void initializeQuad();
 };
 } /* namespace iphito::renderer */
 
@@ -29,19 +29,19 @@ Hermite32D::Hermite32D(std::shared_ptr<Hermite3> curve, double curveWidth,
     Eigen::Vector2d startTangentVector = this->curve->getStartTangentVector();
     Eigen::Vector2d endTangentVector = this->curve->getEndTangentVector();
 
-    this->startTangent.reset(
-            new Arrow2D(startControlPoint, startTangentVector,
-                        startTangentVector.norm(), curveWidth, tangentColor));
-    this->endTangent.reset(
-            new Arrow2D(endControlPoint, endTangentVector,
-                        endTangentVector.norm(), curveWidth, tangentColor));
-
-    this->startControlPoint.reset(new Point2D(startControlPoint,
-                                              this->controlPointsColor,
-                                              curveWidth));
-    this->endControlPoint.reset(new Point2D(endControlPoint,
-                                            this->controlPointsColor,
-                                            curveWidth));
+    this->tangents.reset(new InstancedOverlay());
+    this->tangents->addArrow(startControlPoint, startTangentVector,
+                             startTangentVector.norm(), curveWidth / 2.0,
+                             tangentColor);
+    this->tangents->addArrow(endControlPoint, endTangentVector,
+                             endTangentVector.norm(), curveWidth / 2.0,
+                             tangentColor);
+
+    this->controlPoints.reset(new InstancedOverlay());
+    this->controlPoints->addCircle(startControlPoint, curveWidth,
+                                   this->controlPointsColor);
+    this->controlPoints->addCircle(endControlPoint, curveWidth,
+                                   this->controlPointsColor);
 }
 
 Hermite32D::~Hermite32D() {
@@ -49,48 +49,25 @@ Hermite32D::~Hermite32D() {
     // TODO: Correctly destory buffers
 }
 
-void Hermite32D::render() {
+void Hermite32D::renderUnderlay() {
 
-    if (this->hasToBeRedrawn()) {
-        Curve2D::recomputeVerticesAndIndices();
-    }
-
-    if (Curve2D::viewMatrixUpdate) {
-        this->startTangent->updateViewMatrix(Curve2D::view);
-        this->endTangent->updateViewMatrix(Curve2D::view);
-
-        this->startControlPoint->updateViewMatrix(Curve2D::view);
-        this->endControlPoint->updateViewMatrix(Curve2D::view);
-        Curve2D::viewMatrixUpdate = false;
-    }
+    this->tangents->render(Curve2D::model, Curve2D::depth);
+}
 
-    if (Curve2D::projectionMatrixUpdate) {
-        this->startTangent->updateProjectionMatrix(Curve2D::projection);
-        this->endTangent->updateProjectionMatrix(Curve2D::projection);
+void Hermite32D::renderOverlay() {
 
-        this->startControlPoint->updateProjectionMatrix(Curve2D::projection);
-        this->endControlPoint->updateProjectionMatrix(Curve2D::projection);
-        Curve2D::projectionMatrixUpdate = false;
-    }
+    this->controlPoints->render(Curve2D::model, Curve2D::depth);
+}
 
-    this->startTangent->render();
-    this->endTangent->render();
+AABB Hermite32D::decorationAABB() {
 
-    Curve2D::shader->useProgram();
-    Curve2D::shader->setMatrix4("model", Curve2D::model);
-    Curve2D::shader->setMatrix4("view", Curve2D::view);
-    Curve2D::shader->setMatrix4("projection", Curve2D::projection);
+    return this->tangents->getAABB() + this->controlPoints->getAABB();
+}
 
-    glBindVertexArray(Curve2D::vertexArrayObjectID);
-    glDrawElements(GL_TRIANGLES, Curve2D::indices.size(), GL_UNSIGNED_INT,
-                   NULL);
-    glBindVertexArray(0);
+bool Hermite32D::hasToBeRedrawn() {
 
-    this->startControlPoint->render();
-    this->endControlPoint->render();
+    return Curve2D::isDirty || Curve2D::isUploadPending;
 }
 
-bool Hermite32D::hasToBeRedrawn() { return Curve2D::isDirty; }
-
 } /* namespace iphito::renderer */
 
@@ -13,8 +13,7 @@
 
 #include "src/main/math/Hermite3.h"
 #include "Curve2D.h"
-#include "Arrow2D.h"
-#include "Point2D.h"
+#include "InstancedOverlay.h"
 
 namespace iphito::renderer {
 
@@ -28,17 +27,17 @@ public:
                const Eigen::Vector3d& controlPointsColor);
     ~Hermite32D();
     
-    void render();
     bool hasToBeRedrawn();
+    void renderUnderlay() override;
+    void renderOverlay() override;
+    AABB decorationAABB() override;
 
 private:
     std::shared_ptr<iphito::math::Hermite3> curve;
     Eigen::Vector3d tangentColor;
     Eigen::Vector3d controlPointsColor;
-    std::unique_ptr<Arrow2D> startTangent;
-    std::unique_ptr<Arrow2D> endTangent;
-    std::unique_ptr<Point2D> startControlPoint;
-    std::unique_ptr<Point2D> endControlPoint;
+    std::unique_ptr<InstancedOverlay> tangents;
+    std::unique_ptr<InstancedOverlay> controlPoints;
 };
 
 } /* namespace iphito::renderer */
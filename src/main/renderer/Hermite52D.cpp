@@ -34,80 +34,49 @@ Hermite52D::Hermite52D(std::shared_ptr<Hermite5> curve,
     Eigen::Vector2d endAccelerationVector =
         this->curve->getEndAccelerationVector();
 
-    this->startTangent.reset(new Arrow2D(startControlPoint, startVelocityVector,
-                                         startVelocityVector.norm(), curveWidth,
-                                         tangentColor));
-    this->endTangent.reset(new Arrow2D(endControlPoint, endVelocityVector,
-                                       endVelocityVector.norm(), curveWidth,
-                                       tangentColor));
-
-    this->startSecondDerivative.reset(
-            new Arrow2D(startControlPoint, startAccelerationVector,
-                        startAccelerationVector.norm(), curveWidth,
-                        secondDerivativeColor));
-
-    this->endSecondDerivative.reset(
-            new Arrow2D(endControlPoint, endAccelerationVector,
-                        endAccelerationVector.norm(), curveWidth,
-                        secondDerivativeColor));
-
-    this->startControlPoint.reset(new Point2D(startControlPoint,
-                this->controlPointsColor, curveWidth));
-    this->endControlPoint.reset(new Point2D(endControlPoint,
-                this->controlPointsColor, curveWidth));
+    this->derivatives.reset(new InstancedOverlay());
+    this->derivatives->addArrow(startControlPoint, startVelocityVector,
+                                startVelocityVector.norm(), curveWidth / 2.0,
+                                tangentColor);
+    this->derivatives->addArrow(endControlPoint, endVelocityVector,
+                                endVelocityVector.norm(), curveWidth / 2.0,
+                                tangentColor);
+    this->derivatives->addArrow(startControlPoint, startAccelerationVector,
+                                startAccelerationVector.norm(),
+                                curveWidth / 2.0, secondDerivativeColor);
+    this->derivatives->addArrow(endControlPoint, endAccelerationVector,
+                                endAccelerationVector.norm(),
+                                curveWidth / 2.0, secondDerivativeColor);
+
+    this->controlPoints.reset(new InstancedOverlay());
+    this->controlPoints->addCircle(startControlPoint, curveWidth,
+                                   this->controlPointsColor);
+    this->controlPoints->addCircle(endControlPoint, curveWidth,
+                                   this->controlPointsColor);
 }
 
 Hermite52D::~Hermite52D() {
     // TODO: properly destroy everything if needed
 }
 
-void Hermite52D::render() {
-
-    if (this->hasToBeRedrawn()) {
-        Curve2D::recomputeVerticesAndIndices();
-    }
-
-    if (Curve2D::viewMatrixUpdate) {
-        this->startTangent->updateViewMatrix(Curve2D::view);
-        this->endTangent->updateViewMatrix(Curve2D::view);
-        this->startSecondDerivative->updateViewMatrix(Curve2D::view);
-        this->endSecondDerivative->updateViewMatrix(Curve2D::view);
-
-        this->startControlPoint->updateViewMatrix(Curve2D::view);
-        this->endControlPoint->updateViewMatrix(Curve2D::view);
-        Curve2D::viewMatrixUpdate = false;
-    }
-
-    if (Curve2D::projectionMatrixUpdate) {
-        this->startTangent->updateProjectionMatrix(Curve2D::projection);
-        this->endTangent->updateProjectionMatrix(Curve2D::projection);
-        this->startSecondDerivative->updateProjectionMatrix(Curve2D::projection);
-        this->endSecondDerivative->updateProjectionMatrix(Curve2D::projection);
-
-        this->startControlPoint->updateProjectionMatrix(Curve2D::projection);
-        this->endControlPoint->updateProjectionMatrix(Curve2D::projection);
-        Curve2D::projectionMatrixUpdate = false;
-    }
-
-    this->startTangent->render();
-    this->endTangent->render();
-    this->startSecondDerivative->render();
-    this->endSecondDerivative->render();
-
-    Curve2D::shader->useProgram();
-    Curve2D::shader->setMatrix4("model", Curve2D::model);
-    Curve2D::shader->setMatrix4("view", Curve2D::view);
-    Curve2D::shader->setMatrix4("projection", Curve2D::projection);
-
-    glBindVertexArray(Curve2D::vertexArrayObjectID);
-    glDrawElements(GL_TRIANGLES, Curve2D::indices.size(), GL_UNSIGNED_INT,
-                   NULL);
-    glBindVertexArray(0);
-
-    this->startControlPoint->render();
-    this->endControlPoint->render();
+void Hermite52D::renderUnderlay() {
+
+    this->derivatives->render(Curve2D::model, Curve2D::depth);
 }
 
-bool Hermite52D::hasToBeRedrawn() { return Curve2D::isDirty; }
+void Hermite52D::renderOverlay() {
+
+    this->controlPoints->render(Curve2D::model, Curve2D::depth);
+}
+
+AABB Hermite52D::decorationAABB() {
+
+    return this->derivatives->getAABB() + this->controlPoints->getAABB();
+}
+
+bool Hermite52D::hasToBeRedrawn() {
+
+    return Curve2D::isDirty || Curve2D::isUploadPending;
+}
 
 } /* namespace iphito::renderer */
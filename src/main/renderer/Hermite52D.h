@@ -13,8 +13,7 @@
 
 #include "src/main/math/Hermite5.h"
 #include "Curve2D.h"
-#include "Arrow2D.h"
-#include "Point2D.h"
+#include "InstancedOverlay.h"
 
 namespace iphito::renderer {
 
@@ -29,20 +28,18 @@ public:
                const Eigen::Vector3d& controlPointsColor);
     ~Hermite52D();
     
-    void render();
     bool hasToBeRedrawn();
+    void renderUnderlay() override;
+    void renderOverlay() override;
+    AABB decorationAABB() override;
 
 private:
     std::shared_ptr<iphito::math::Hermite5> curve;
     Eigen::Vector3d tangentColor;
     Eigen::Vector3d secondDerivativeColor;
     Eigen::Vector3d controlPointsColor;
-    std::unique_ptr<Arrow2D> startTangent;
-    std::unique_ptr<Arrow2D> endTangent;
-    std::unique_ptr<Arrow2D> startSecondDerivative;
-    std::unique_ptr<Arrow2D> endSecondDerivative;
-    std::shared_ptr<Point2D> startControlPoint;
-    std::shared_ptr<Point2D> endControlPoint;
+    std::unique_ptr<InstancedOverlay> derivatives;
+    std::unique_ptr<InstancedOverlay> controlPoints;
 };
 
 } /* namespace iphito::renderer */
@@ -0,0 +1,316 @@
+/**
+ * @file InstancedOverlay.cpp
+ * @brief Implements the instanced drawing of points, segments and arrows
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-24
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "InstancedOverlay.h"
+#include "ShaderRegistry.h"
+
+#include "src/main/utils/Utils.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::utils;
+
+InstancedOverlay::InstancedOverlay() : isUploadPending{false},
+    bounds{AABB::empty()} {
+
+    if(!Utils::isGlfwInitialized())
+        throw std::runtime_error("Please initialize GLFW.");
+
+    if(!Utils::isGlewInitialized())
+        throw std::runtime_error("Please initialize Glew.");
+
+    this->shader = ShaderRegistry::Instance()->get("overlay.vert",
+                                                   "overlay.frag");
+    this->discShader = ShaderRegistry::Instance()->get("overlay.vert",
+                                                       "point.frag");
+
+    glGenVertexArrays(shapeCount, this->vertexArrayObjectIDs.data());
+    glGenBuffers(shapeCount, this->instanceBufferIDs.data());
+
+    for (int i = 0; i < shapeCount; i++) {
+        const Mesh& mesh = InstancedOverlay::getMesh(static_cast<Shape>(i));
+
+        glBindVertexArray(this->vertexArrayObjectIDs[i]);
+
+        glBindBuffer(GL_ARRAY_BUFFER, mesh.vertexBufferID);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+        glEnableVertexAttribArray(0);
+
+        glBindBuffer(GL_ARRAY_BUFFER, this->instanceBufferIDs[i]);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                reinterpret_cast<const void*>(offsetof(Instance, position)));
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                reinterpret_cast<const void*>(offsetof(Instance, direction)));
+        glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                reinterpret_cast<const void*>(offsetof(Instance, scale)));
+        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                reinterpret_cast<const void*>(offsetof(Instance, color)));
+        glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(Instance),
+                reinterpret_cast<const void*>(offsetof(Instance, thickness)));
+
+        for (GLuint attribute = 1; attribute <= 5; attribute++) {
+            glEnableVertexAttribArray(attribute);
+            glVertexAttribDivisor(attribute, 1);
+        }
+    }
+
+    glBindVertexArray(0);
+}
+
+InstancedOverlay::~InstancedOverlay() {
+
+    glDeleteVertexArrays(shapeCount, this->vertexArrayObjectIDs.data());
+    glDeleteBuffers(shapeCount, this->instanceBufferIDs.data());
+}
+
+/**
+ * Adds a disc, or a ring of the given width centred on the circle when the
+ * width is positive.
+ */
+void InstancedOverlay::addCircle(const Eigen::Vector2d& center, double radius,
+                                 const Eigen::Vector3d& color, double width) {
+
+    if (width < 0.0)
+        throw std::domain_error("The width cannot be negative.");
+
+    if (width == 0.0) {
+        this->add(circle, center, Eigen::Vector2d(1.0, 0.0),
+                  Eigen::Vector2d(radius, radius), color);
+        return;
+    }
+
+    double outerRadius = radius + 0.5 * width;
+    this->add(circle, center, Eigen::Vector2d(1.0, 0.0),
+              Eigen::Vector2d(outerRadius, outerRadius), color,
+              std::min(width / outerRadius, 1.0));
+}
+
+void InstancedOverlay::addSegment(const Eigen::Vector2d& start,
+                                  const Eigen::Vector2d& end,
+                                  double halfWidth,
+                                  const Eigen::Vector3d& color) {
+
+    Eigen::Vector2d direction = end - start;
+    if (direction.isZero()) return;
+
+    this->add(segment, start, direction,
+              Eigen::Vector2d(direction.norm(), halfWidth), color);
+}
+
+void InstancedOverlay::addArrow(const Eigen::Vector2d& origin,
+                                const Eigen::Vector2d& direction,
+                                double length, double halfWidth,
+                                const Eigen::Vector3d& color) {
+
+    if (direction.isZero()) return;
+
+    this->add(arrow, origin, direction, Eigen::Vector2d(length, halfWidth),
+              color);
+}
+
+void InstancedOverlay::clear() {
+
+    for (auto& i : this->instances) i.clear();
+    this->bounds = AABB::empty();
+    this->isUploadPending = true;
+}
+
+/**
+ * Draws the instances at the depth of the curve they decorate, which only
+ * matters with the depth test of the layers.
+ */
+void InstancedOverlay::render(const Eigen::Matrix4d& model, double depth) {
+
+    if (this->isUploadPending) this->upload();
+
+    for (int i = 0; i < shapeCount; i++) {
+        if (this->instances[i].empty()) continue;
+
+        Shader& shader = i == circle ? *this->discShader : *this->shader;
+        shader.useProgram();
+        shader.setMatrix4("model", model);
+        shader.setFloat("depth", depth);
+
+        glBindVertexArray(this->vertexArrayObjectIDs[i]);
+        glDrawArraysInstanced(GL_TRIANGLES, 0,
+                InstancedOverlay::getMesh(static_cast<Shape>(i)).vertexCount,
+                this->instances[i].size());
+    }
+
+    glBindVertexArray(0);
+}
+
+void InstancedOverlay::add(Shape shape, const Eigen::Vector2d& position,
+                           const Eigen::Vector2d& direction,
+                           const Eigen::Vector2d& scale,
+                           const Eigen::Vector3d& color, double thickness) {
+
+    Eigen::Vector2f p = position.cast<GLfloat>();
+    Eigen::Vector2f d = direction.cast<GLfloat>();
+    Eigen::Vector2f s = scale.cast<GLfloat>();
+    Eigen::Vector3f c = color.cast<GLfloat>();
+
+    this->instances[shape].push_back({{p[0], p[1]}, {d[0], d[1]},
+                                      {s[0], s[1]}, {c[0], c[1], c[2]},
+                                      static_cast<GLfloat>(thickness)});
+    this->isUploadPending = true;
+
+    /* The extent of the unit mesh, placed as in overlay.vert, gives the
+     * ranges of the instance along and across its direction. */
+    const Extent& extent = InstancedOverlay::getExtent(shape);
+    const Eigen::Vector2d along = direction.normalized();
+    const Eigen::Vector2d across(-along[1], along[0]);
+
+    auto range = [](double min, double max, double factor) {
+        return Eigen::Vector2d(std::min(factor * min, factor * max),
+                               std::max(factor * min, factor * max));
+    };
+
+    const Eigen::Vector2d u = range(extent.min[0], extent.max[0], scale[0]) +
+                              range(extent.min[2], extent.max[2], scale[1]);
+    const Eigen::Vector2d v = range(extent.min[1], extent.max[1], scale[1]);
+
+    Eigen::Vector2d min = Eigen::Vector2d::Constant(
+            std::numeric_limits<double>::infinity());
+    Eigen::Vector2d max = -min;
+
+    for (double a : {u[0], u[1]}) {
+        for (double b : {v[0], v[1]}) {
+            Eigen::Vector2d corner = position + a * along + b * across;
+            min = min.cwiseMin(corner);
+            max = max.cwiseMax(corner);
+        }
+    }
+
+    this->bounds = this->bounds + AABB(min, max);
+}
+
+/**
+ * Box containing every instance, in the space of the model matrix.
+ */
+AABB InstancedOverlay::getAABB() {
+
+    return this->bounds;
+}
+
+void InstancedOverlay::upload() {
+
+    for (int i = 0; i < shapeCount; i++) {
+        glBindBuffer(GL_ARRAY_BUFFER, this->instanceBufferIDs[i]);
+        glBufferData(GL_ARRAY_BUFFER,
+                     this->instances[i].size() * sizeof(Instance),
+                     this->instances[i].data(), GL_STATIC_DRAW);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    this->isUploadPending = false;
+}
+
+/**
+ * The unit meshes are uploaded on first use and live as long as the process.
+ */
+const InstancedOverlay::Mesh& InstancedOverlay::getMesh(Shape shape) {
+
+    static const std::array<Mesh, shapeCount> meshes = [] {
+        std::array<Mesh, shapeCount> meshes;
+
+        for (int i = 0; i < shapeCount; i++) {
+            std::vector<GLfloat> vertices =
+                InstancedOverlay::unitMesh(static_cast<Shape>(i));
+
+            glGenBuffers(1, &meshes[i].vertexBufferID);
+            glBindBuffer(GL_ARRAY_BUFFER, meshes[i].vertexBufferID);
+            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat),
+                         vertices.data(), GL_STATIC_DRAW);
+            meshes[i].vertexCount = vertices.size() / 3;
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        return meshes;
+    }();
+
+    return meshes[shape];
+}
+
+/**
+ * The extents of the unit meshes are computed on first use, once per process.
+ */
+const InstancedOverlay::Extent& InstancedOverlay::getExtent(Shape shape) {
+
+    static const std::array<Extent, shapeCount> extents = [] {
+        std::array<Extent, shapeCount> extents;
+
+        for (int i = 0; i < shapeCount; i++) {
+            std::vector<GLfloat> mesh =
+                InstancedOverlay::unitMesh(static_cast<Shape>(i));
+            Eigen::Map<const Eigen::Matrix3Xf> vertices(mesh.data(), 3,
+                                                        mesh.size() / 3);
+
+            extents[i].min = vertices.rowwise().minCoeff().cast<double>();
+            extents[i].max = vertices.rowwise().maxCoeff().cast<double>();
+        }
+
+        return extents;
+    }();
+
+    return extents[shape];
+}
+
+/**
+ * Triangles of the unit shapes, as (x, y, z) vertices where x is measured
+ * along the direction in lengths, y across it in widths and z along it in
+ * widths. The head of an arrow thus keeps its size whatever its length, as
+ * the one drawn by Arrow2D.
+ */
+std::vector<GLfloat> InstancedOverlay::unitMesh(Shape shape) {
+
+    std::vector<GLfloat> mesh;
+
+    auto vertex = [&mesh](GLfloat x, GLfloat y, GLfloat z) {
+        mesh.insert(mesh.end(), {x, y, z});
+    };
+
+    const GLfloat q = InstancedOverlay::discQuadSize;
+
+    switch (shape) {
+    case circle:
+        vertex(-q, -q, 0.0);
+        vertex(q, -q, 0.0);
+        vertex(q, q, 0.0);
+
+        vertex(-q, -q, 0.0);
+        vertex(q, q, 0.0);
+        vertex(-q, q, 0.0);
+        break;
+    case arrow:
+        vertex(1.0, 3.0, 0.0);
+        vertex(1.0, -3.0, 0.0);
+        vertex(1.0, 0.0, 4.0 * std::sqrt(3.0));
+        [[fallthrough]];
+    case segment:
+        vertex(0.0, 1.0, 0.0);
+        vertex(0.0, -1.0, 0.0);
+        vertex(1.0, -1.0, 0.0);
+
+        vertex(0.0, 1.0, 0.0);
+        vertex(1.0, -1.0, 0.0);
+        vertex(1.0, 1.0, 0.0);
+        break;
+    default:
+        break;
+    }
+
+    return mesh;
+}
+
+} /* namespace iphito::renderer */
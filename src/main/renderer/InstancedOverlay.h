@@ -0,0 +1,97 @@
+/**
+ * @file InstancedOverlay.h
+ * @brief Describes the instanced drawing of points, segments and arrows
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-24
+ */
+#ifndef INSTANCED_OVERLAY_H
+#define INSTANCED_OVERLAY_H
+
+#include <array>
+#include <memory>
+#include <vector>
+#include <Eigen/Core>
+#include <GL/glew.h>
+
+#include "AABB.h"
+#include "Shader.h"
+
+namespace iphito::renderer {
+
+/**
+ * Draws the decorations of a curve, i.e. control points, control polygon
+ * edges and derivative arrows, with one instanced draw call per shape. The
+ * unit meshes of the shapes are built and uploaded once per process and
+ * shared by all the overlays. Every instance only stores its position,
+ * direction, scale, thickness and color.
+ *
+ * Discs are a single quad each, whose fragments are covered according to
+ * their signed distance to the circle, antialiased over a pixel. A circle
+ * with a width is drawn as a ring of that thickness around it. Drawing them
+ * requires blending.
+ */
+class InstancedOverlay {
+
+public:
+    InstancedOverlay();
+    ~InstancedOverlay();
+
+    void addCircle(const Eigen::Vector2d& center, double radius,
+                   const Eigen::Vector3d& color, double width = 0.0);
+    void addSegment(const Eigen::Vector2d& start, const Eigen::Vector2d& end,
+                    double halfWidth, const Eigen::Vector3d& color);
+    void addArrow(const Eigen::Vector2d& origin,
+                  const Eigen::Vector2d& direction, double length,
+                  double halfWidth, const Eigen::Vector3d& color);
+    void clear();
+    AABB getAABB();
+    void render(const Eigen::Matrix4d& model, double depth = 0.0);
+
+private:
+    enum Shape { circle, segment, arrow, shapeCount };
+
+    struct Instance {
+        GLfloat position[2];
+        GLfloat direction[2];
+        GLfloat scale[2];
+        GLfloat color[3];
+        /* Part of a disc covered from its rim inwards, in radii. */
+        GLfloat thickness;
+    };
+
+    struct Mesh {
+        GLuint vertexBufferID;
+        GLsizei vertexCount;
+    };
+
+    /* Box of the vertices of a unit mesh. */
+    struct Extent {
+        Eigen::Vector3d min;
+        Eigen::Vector3d max;
+    };
+
+    /* Half side of the quad of a disc in radii, leaving room to antialias. */
+    static constexpr double discQuadSize = 1.25;
+
+    std::shared_ptr<Shader> shader;
+    std::shared_ptr<Shader> discShader;
+    std::array<std::vector<Instance>, shapeCount> instances;
+    std::array<GLuint, shapeCount> vertexArrayObjectIDs;
+    std::array<GLuint, shapeCount> instanceBufferIDs;
+    bool isUploadPending;
+    AABB bounds;
+
+    void add(Shape shape, const Eigen::Vector2d& position,
+             const Eigen::Vector2d& direction, const Eigen::Vector2d& scale,
+             const Eigen::Vector3d& color, double thickness = 1.0);
+    void upload();
+
+    static const Mesh& getMesh(Shape shape);
+    static const Extent& getExtent(Shape shape);
+    static std::vector<GLfloat> unitMesh(Shape shape);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef INSTANCED_OVERLAY_H */
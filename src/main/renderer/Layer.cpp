@@ -5,36 +5,59 @@
  * @version 1.0
  * @date 2018-09-14
  */
+#include <algorithm>
+#include <cmath>
 #include <vector>
+#include <Eigen/Dense>
 #include "Layer.h"
 
 namespace iphito::renderer {
 
 std::atomic<unsigned long long> Layer::nextID = 0;
 
+/* Curves start with version 0, i.e. without a camera. */
+std::atomic<unsigned long long> Layer::nextCameraVersion = 1;
+
 Layer::Layer(std::vector<std::unique_ptr<Layer>> children, 
-             std::vector<std::unique_ptr<Curve2D>> curves) {
+             std::vector<std::unique_ptr<Curve2D>> curves) :
+    parent{nullptr}, sceneIndex{std::make_shared<SceneIndex>()},
+    camera{std::make_shared<TreeCamera>(TreeCamera{
+        Eigen::Matrix4d::Identity(), Eigen::Matrix4d::Identity(), 0, 0,
+        AABB::unbounded(), Layer::nextCameraVersion.fetch_add(1)})},
+    isIndexDirty{true}, pixelReach{0.0}, subtreePixelReach{0.0},
+    isAABBDirty{true} {
 
     this->id = this->nextID.fetch_add(1);
+    this->sceneIndex->insertLayer(this->id, this);
 
     for (auto& i : children) {
-        this->children.insert({i->getID(), std::move(i)});
+        std::unique_ptr<Layer> j = std::move(i);
+        this->addLayer(j);
     }
 
     for (auto& i : curves) {
-        this->curves.insert({i->getID(), std::move(i)});
+        std::unique_ptr<Curve2D> j = std::move(i);
+        this->addCurve(j);
     }
 }
 
 Layer::~Layer() {}
 
+/**
+ * A curve can only be once in a tree of layers. It is given the camera of the
+ * tree once it is visible.
+ */
 bool Layer::addCurve(std::unique_ptr<Curve2D>& curve) {
 
     unsigned long long curveID = curve->getID();
 
-    if(this->containsCurve(curveID)) return false;
+    if(this->sceneIndex->findCurveOwner(curveID) != nullptr) return false;
 
+    curve->cameraVersion = 0;
+    this->sceneIndex->insertCurve(curveID, this);
+    curve->layer = this;
     this->curves.insert({curveID, std::move(curve)});
+    this->invalidateIndex();
     return true;
 }
 
@@ -47,14 +70,24 @@ void Layer::addCurves(std::vector<std::unique_ptr<Curve2D>> curves) {
     }
 }
 
+/**
+ * Grafts the tree of the layer, whose index is merged into the one of this
+ * tree, and shares the camera of this tree with it. A layer can only be once
+ * in a tree of layers.
+ */
 bool Layer::addLayer(std::unique_ptr<Layer>& layer) {
 
     unsigned long long layerID = layer->getID();
 
-    if(this->getID() == layerID) return false;
-    if(this->containsLayer(layerID)) return false;
+    if(this->sceneIndex->findLayer(layerID) != nullptr) return false;
+
+    this->sceneIndex->merge(*layer->sceneIndex);
+    layer->setSceneIndex(this->sceneIndex);
+    layer->parent = this;
+    layer->setCamera(this->camera);
 
     this->children.insert({layerID, std::move(layer)});
+    this->invalidateAABB();
     return true;
 }
 
@@ -67,78 +100,411 @@ void Layer::addLayers(std::vector<std::unique_ptr<Layer>> layers) {
 }
 
 bool Layer::containsCurve(unsigned long long id) {
-    
-    if(this->curves.find(id) != this->curves.end()) return true;
-
-    for(auto& i : this->children)
-        if(i.second->containsCurve(id)) return true;
 
-    return false;
+    Layer* owner = this->sceneIndex->findCurveOwner(id);
+    return owner != nullptr && this->encloses(owner);
 }
 
 bool Layer::containsLayer(unsigned long long id) {
-    
-    if(this->children.find(id) != this->children.end()) return true;
 
-    for(auto& i : this->children)
-        if(i.second->containsLayer(id)) return true;
+    Layer* layer = this->sceneIndex->findLayer(id);
+    return layer != nullptr && layer != this && this->encloses(layer);
+}
+
+Curve2D* Layer::findCurve(unsigned long long id) {
 
-    return false;
+    Layer* owner = this->sceneIndex->findCurveOwner(id);
+    if (owner == nullptr || !this->encloses(owner)) return nullptr;
+
+    return owner->curves.at(id).get();
 }
 
-bool Layer::removeCurve(unsigned long long id) {
+/**
+ * Finds the curve of the layer and of its descendants closest to a point of
+ * the world, among the ones closer than the radius. Only the layers and the
+ * curves whose box is within the radius of the point are looked at.
+ */
+bool Layer::pick(const Eigen::Vector2d& point, double radius,
+                 CurvePick& pick) {
+
+    const Eigen::Vector2d margin = Eigen::Vector2d::Constant(radius);
+    const AABB region(point - margin, point + margin);
+    bool isPicked = false;
+
+    for (auto& i : this->children) {
+        if (i.second->getAABB().intersects(region) &&
+            i.second->pick(point, radius, pick)) {
+            radius = pick.distance;
+            isPicked = true;
+        }
+    }
+
+    this->updateIndex();
 
-    if(this->curves.erase(id) != 1) {
+    this->pickedCurves.clear();
+    this->curveIndex.query(region, this->pickedCurves);
 
-        for (auto& i : this->children) {
-            if(i.second->removeCurve(id)) return true;
+    for (int i : this->pickedCurves) {
+        if (this->indexedCurves[i]->closestPoint(point, radius, pick)) {
+            radius = pick.distance;
+            isPicked = true;
         }
+    }
+
+    return isPicked;
+}
+
+bool Layer::removeCurve(unsigned long long id) {
+
+    if(!this->containsCurve(id)) return false;
+
+    Layer* owner = this->sceneIndex->findCurveOwner(id);
+    this->sceneIndex->eraseCurve(id);
+    owner->curves.erase(id);
+    owner->invalidateIndex();
+
+    return true;
+}
+
+bool Layer::removeLayer(unsigned long long id) {
+
+    if(!this->containsLayer(id)) return false;
 
-        return false;
+    Layer* layer = this->sceneIndex->findLayer(id);
+    Layer* parent = layer->parent;
+    layer->unindex();
+    parent->children.erase(id);
+    parent->invalidateAABB();
+
+    return true;
+}
+
+/**
+ * Whether the layer is this one or one of its descendants, found by walking up
+ * its ancestors.
+ */
+bool Layer::encloses(Layer* layer) {
+
+    for (Layer* i = layer; i != nullptr; i = i->parent) {
+        if (i == this) return true;
     }
-    else {
-        return true;
+
+    return false;
+}
+
+void Layer::setSceneIndex(const std::shared_ptr<SceneIndex>& index) {
+
+    this->sceneIndex = index;
+
+    for (auto& i : this->children) {
+        i.second->setSceneIndex(index);
     }
 }
 
-bool Layer::removeLayer(unsigned long long id) {
+/**
+ * The versions of the cameras are unique, so the curves of the layer are given
+ * the new camera once they are visible.
+ */
+void Layer::setCamera(const std::shared_ptr<TreeCamera>& camera) {
 
-    if(this->children.erase(id) != 1) {
+    this->camera = camera;
 
-        for (auto& i : this->children) {
-            if(i.second->removeLayer(id)) return true;
-        }
+    for (auto& i : this->children) {
+        i.second->setCamera(camera);
+    }
+}
+
+/**
+ * Removes the layer, its curves and its descendants from the index.
+ */
+void Layer::unindex() {
 
-        return false;
+    this->sceneIndex->eraseLayer(this->id);
+
+    for (auto& i : this->curves) {
+        this->sceneIndex->eraseCurve(i.first);
     }
 
-    return true;
+    for (auto& i : this->children) {
+        i.second->unindex();
+    }
 }
 
+/**
+ * The visible curves of the layer are drawn in three passes: their underlays,
+ * their strokes together in a single batch, then their overlays (tangents,
+ * control points...). Every curve has its own depth, nearer than the curves
+ * before it, so that the depth test still draws every curve and its
+ * decorations over the ones before it.
+ */
 void Layer::render() {
 
     // back to front rendering to ensure correct order.
     for(auto i = this->children.rbegin(); i != this->children.rend(); i++) {
-        i->second->render();
+        AABB box = this->grownByPixels(i->second->getAABB(),
+                                       i->second->getPixelReach());
+        if (box.intersects(this->cullingAABB())) i->second->render();
     }
 
-    for(auto i = this->curves.rbegin(); i != this->curves.rend(); i++) {
-        i->second->render();
+    if(this->curves.empty()) return;
+
+    /* The curves were given the view when collected for tessellation. */
+    this->curvesToRender.clear();
+    this->collectVisibleCurves(this->curvesToRender);
+
+    if(this->curvesToRender.empty()) return;
+
+    for(auto& i : this->curvesToRender) {
+        this->updateCamera(i);
+        i->prepare();
     }
+
+    if(!this->strokeBatch) this->strokeBatch.reset(new StrokeBatch());
+    this->strokeBatch->update(this->curvesToRender);
+
+    /* The depths only order the curves of this layer. */
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+
+    for(auto& i : this->curvesToRender) {
+        i->renderUnderlay();
+    }
+
+    this->strokeBatch->render();
+
+    for(auto& i : this->curvesToRender) {
+        i->renderOverlay();
+    }
+
+    glDisable(GL_DEPTH_TEST);
 }
 
-void Layer::updateViewMatrix(const Eigen::Matrix4d& view) {
+/**
+ * Gives the camera to the visible curves of the tree, and appends the ones
+ * which have to be tessellated again.
+ */
+void Layer::collectCurvesToTessellate(std::vector<Curve2D*>& curves) {
 
-    for(auto i = this->curves.rbegin(); i != this->curves.rend(); i++) {
-        i->second->updateViewMatrix(view);
+    for (auto& i : this->children) {
+        AABB box = this->grownByPixels(i.second->getAABB(),
+                                       i.second->getPixelReach());
+        if (box.intersects(this->cullingAABB()))
+            i.second->collectCurvesToTessellate(curves);
+    }
+
+    std::vector<Curve2D*> visible;
+    this->collectVisibleCurves(visible);
+
+    for (auto& i : visible) {
+        this->updateCamera(i);
+        if (i->hasToBeTessellated()) curves.push_back(i);
     }
 }
 
-void Layer::updateProjectionMatrix(const Eigen::Matrix4d& projection) {
+/**
+ * Appends the curves intersecting the view in drawing order. The view is
+ * grown by the reach of the widest stroke in pixels, so a few curves just
+ * outside of it may be kept.
+ */
+void Layer::collectVisibleCurves(std::vector<Curve2D*>& curves) {
+
+    this->updateIndex();
+
+    this->visibleCurves.clear();
+    this->curveIndex.query(this->grownByPixels(this->cullingAABB(),
+                                               this->pixelReach),
+                           this->visibleCurves);
+
+    for (int i : this->visibleCurves) {
+        curves.push_back(this->indexedCurves[i]);
+    }
+}
+
+/**
+ * The view grown by the culling margin, against which both the child layers
+ * and the curves are culled.
+ */
+AABB Layer::cullingAABB() {
+
+    return this->camera->viewAABB.expandedBy(Layer::cullingMargin);
+}
+
+/**
+ * Gives the camera of the tree to a curve, unless it has it already.
+ */
+void Layer::updateCamera(Curve2D* curve) {
+
+    const TreeCamera& camera = *this->camera;
+
+    if (curve->cameraVersion != camera.version) {
+        curve->updateViewMatrix(camera.view);
+        curve->updateProjectionMatrix(camera.projection);
+        curve->updateViewportSize(camera.viewportWidth, camera.viewportHeight);
+        curve->cameraVersion = camera.version;
+    }
+
+    curve->updateViewAABB(camera.viewAABB);
+}
+
+void Layer::invalidateCamera() {
+
+    this->camera->version = Layer::nextCameraVersion.fetch_add(1);
+}
+
+/**
+ * Number of pixels per world unit along the direction the camera shrinks the
+ * most. It is 0 with an empty viewport, on which nothing is drawn.
+ */
+double Layer::pixelsPerUnit() {
+
+    const TreeCamera& camera = *this->camera;
+
+    if (camera.viewportWidth <= 0 || camera.viewportHeight <= 0) return 0.0;
+
+    Eigen::Matrix2d viewport = Eigen::Matrix2d::Identity();
+    viewport(0, 0) = camera.viewportWidth / 2.0;
+    viewport(1, 1) = camera.viewportHeight / 2.0;
+
+    const Eigen::Matrix2d linear = viewport *
+        (camera.projection * camera.view).topLeftCorner<2, 2>();
+
+    return linear.jacobiSvd().singularValues().minCoeff();
+}
+
+/**
+ * Grows a box of the world by a distance in pixels, with the current camera.
+ */
+AABB Layer::grownByPixels(AABB box, double pixels) {
+
+    if (pixels == 0.0) return box;
+
+    const double margin = pixels / this->pixelsPerUnit();
+    if (!std::isfinite(margin)) return box;
+
+    const Eigen::Vector2d delta = Eigen::Vector2d::Constant(margin);
+
+    return AABB(box.getMin() - delta, box.getMax() + delta);
+}
+
+/**
+ * The curves of the layer were added or removed, or the box of one of them
+ * changed.
+ */
+void Layer::invalidateIndex() {
+
+    this->isIndexDirty = true;
+    this->invalidateAABB();
+}
+
+/**
+ * Marks the box of the layer and of its ancestors as dirty. The ancestors of
+ * a dirty layer are dirty already, so the walk stops at the first one.
+ */
+void Layer::invalidateAABB() {
+
+    for (Layer* i = this; i != nullptr && !i->isAABBDirty; i = i->parent) {
+        i->isAABBDirty = true;
+    }
+}
+
+/**
+ * Rebuilds the hierarchy once its curves changed, and gives every curve the
+ * depth of its place in the drawing order. The depth is counted from the last
+ * curve drawn, so that adding a curve, which is drawn first, leaves the depths
+ * of the others as they are.
+ */
+void Layer::updateIndex() {
+
+    if (!this->isIndexDirty) return;
+
+    this->indexedCurves.clear();
+    std::vector<AABB> boxes;
+    this->pixelReach = 0.0;
 
     for(auto i = this->curves.rbegin(); i != this->curves.rend(); i++) {
-        i->second->updateProjectionMatrix(projection);
+        this->indexedCurves.push_back(i->second.get());
+        boxes.push_back(i->second->getAABB());
+        this->pixelReach = std::max(this->pixelReach,
+                                    i->second->getPixelReach());
+    }
+
+    const int size = this->indexedCurves.size();
+
+    for (int i = 0; i < size; i++) {
+        double depth = -1.0 + (size - i) * Layer::depthStep;
+        this->indexedCurves[i]->setDepth(std::min(depth, 1.0));
+    }
+
+    this->curveIndex.build(boxes);
+    this->isIndexDirty = false;
+}
+
+/**
+ * Box containing every curve of the layer and of its descendants, computed
+ * again only once one of them changed. The strokes with a width in pixels
+ * reach getPixelReach pixels further.
+ */
+AABB Layer::getAABB() {
+
+    if (!this->isAABBDirty) return this->aabb;
+
+    this->updateIndex();
+
+    AABB box = this->curveIndex.getAABB();
+    double reach = this->pixelReach;
+
+    for (auto& i : this->children) {
+        box = box + i.second->getAABB();
+        reach = std::max(reach, i.second->getPixelReach());
     }
+
+    this->aabb = box;
+    this->subtreePixelReach = reach;
+    this->isAABBDirty = false;
+    return box;
+}
+
+/**
+ * Largest reach in pixels of the strokes of the layer and of its descendants.
+ */
+double Layer::getPixelReach() {
+
+    this->getAABB();
+
+    return this->subtreePixelReach;
+}
+
+/**
+ * The camera is shared by the whole tree: the curves are given the new view
+ * once they are visible.
+ */
+void Layer::updateViewMatrix(const Eigen::Matrix4d& view) {
+
+    this->camera->view = view;
+    this->invalidateCamera();
+}
+
+void Layer::updateProjectionMatrix(const Eigen::Matrix4d& projection) {
+
+    this->camera->projection = projection;
+    this->invalidateCamera();
+}
+
+/**
+ * A minimized window has an empty framebuffer, on which nothing is drawn: the
+ * curves keep the previous size.
+ */
+void Layer::updateViewportSize(int width, int height) {
+
+    this->camera->viewportWidth = width;
+    this->camera->viewportHeight = height;
+    this->invalidateCamera();
+}
+
+void Layer::updateViewAABB(const AABB& viewAABB) {
+
+    this->camera->viewAABB = viewAABB;
 }
 
 } /* namespace iphito::renderer */
@@ -15,10 +15,36 @@
 
 #include <Eigen/Core>
 
+#include "AABB.h"
+#include "BoundingVolumeHierarchy.h"
 #include "Curve2D.h"
+#include "SceneIndex.h"
+#include "StrokeBatch.h"
 
 namespace iphito::renderer {
 
+/**
+ * A group of curves and of child layers.
+ *
+ * The boxes of the curves are indexed in a bounding volume hierarchy, so that
+ * only the curves intersecting the view are tessellated and drawn, at a cost
+ * which depends on the visible curves only. Child layers outside of the view
+ * are skipped entirely. The box of the whole subtree of every layer is cached,
+ * and marked dirty along the ancestors when a curve or a layer below changes.
+ *
+ * The camera is shared by all the layers of a tree, so that moving it costs
+ * the same whatever the size of the tree. A curve is only given the camera
+ * once it is visible, when its version of the camera is older. Strokes with a
+ * width in pixels cover another part of the world at every zoom, so their
+ * reach is added to the boxes when culling instead of being indexed.
+ *
+ * Every layer knows its parent, and all the layers of a tree share a
+ * SceneIndex, so that finding, checking and removing a curve or a layer does
+ * not go through the whole tree.
+ *
+ * Picking the curve closest to a point goes through the same hierarchies, so
+ * that it only looks at the curves near the point.
+ */
 class Layer {
 
 public:
@@ -37,16 +63,80 @@ public:
     bool containsLayer(unsigned long long id);
     bool removeCurve(unsigned long long id);
     bool removeLayer(unsigned long long id);
+    Curve2D* findCurve(unsigned long long id);
+    bool pick(const Eigen::Vector2d& point, double radius, CurvePick& pick);
     void render();
+    void collectCurvesToTessellate(std::vector<Curve2D*>& curves);
     void updateViewMatrix(const Eigen::Matrix4d& view);
     void updateProjectionMatrix(const Eigen::Matrix4d& projection);
+    void updateViewportSize(int width, int height);
+    void updateViewAABB(const AABB& viewAABB);
+    AABB getAABB();
+
+    /* Fraction of the view size by which the view is grown to find the
+     * visible layers and curves. */
+    static constexpr double cullingMargin = 0.01;
+
+    /* Depth between two consecutive curves, in normalized device
+     * coordinates: four steps of a 24 bits depth buffer. */
+    static constexpr double depthStep = 1.0 / (1 << 21);
         
 
 private:
+    friend class Curve2D;
+
+    /* The camera of a tree, given to the curves once they are visible. Every
+     * change gives it a new version, unique among all the trees. */
+    struct TreeCamera {
+        Eigen::Matrix4d view;
+        Eigen::Matrix4d projection;
+        int viewportWidth;
+        int viewportHeight;
+        AABB viewAABB;
+        unsigned long long version;
+    };
+
     static std::atomic<unsigned long long> nextID;
+    static std::atomic<unsigned long long> nextCameraVersion;
     unsigned long long id;
+    Layer* parent;
+    std::shared_ptr<SceneIndex> sceneIndex;
+    std::shared_ptr<TreeCamera> camera;
     std::map<unsigned long long, std::unique_ptr<Layer>> children;
     std::map<unsigned long long, std::unique_ptr<Curve2D>> curves;
+    std::vector<Curve2D*> curvesToRender;
+    std::unique_ptr<StrokeBatch> strokeBatch;
+
+    /* The curves in drawing order and the hierarchy over their boxes. */
+    std::vector<Curve2D*> indexedCurves;
+    BoundingVolumeHierarchy curveIndex;
+    bool isIndexDirty;
+
+    /* Largest reach in pixels of the strokes of the curves of the layer. */
+    double pixelReach;
+
+    /* Box of the curves of the layer and of its descendants, and the largest
+     * reach in pixels of their strokes. */
+    AABB aabb;
+    double subtreePixelReach;
+    bool isAABBDirty;
+    std::vector<int> visibleCurves;
+    std::vector<int> pickedCurves;
+
+    bool encloses(Layer* layer);
+    void setSceneIndex(const std::shared_ptr<SceneIndex>& index);
+    void setCamera(const std::shared_ptr<TreeCamera>& camera);
+    void updateCamera(Curve2D* curve);
+    void invalidateCamera();
+    double pixelsPerUnit();
+    AABB grownByPixels(AABB box, double pixels);
+    double getPixelReach();
+    void unindex();
+    AABB cullingAABB();
+    void invalidateIndex();
+    void invalidateAABB();
+    void updateIndex();
+    void collectVisibleCurves(std::vector<Curve2D*>& curves);
 };
 
 } /* namespace iphito::renderer */
@@ -0,0 +1,114 @@
+/**
+ * @file LevelOfDetail.cpp
+ * @brief Implements the zoom levels and the cache slots of tessellations
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-27
+ */
+#include <cmath>
+#include <stdexcept>
+
+#include "LevelOfDetail.h"
+
+namespace iphito::renderer {
+
+LevelOfDetail::LevelOfDetail(int capacity, double hysteresis) :
+    capacity{capacity}, hysteresis{hysteresis}, level{LevelOfDetail::noLevel},
+    clock{0} {
+
+    if (capacity <= 0)
+        throw std::domain_error("The capacity has to be positive.");
+}
+
+/**
+ * Moves to the level of the given scale if needed.
+ *
+ * @return true if the level changed.
+ */
+bool LevelOfDetail::update(double scale) {
+
+    if (!(scale > 0.0) || !std::isfinite(scale)) return false;
+
+    double exact = std::log2(scale);
+    int required = static_cast<int>(std::floor(exact));
+
+    if (required > this->level ||
+        exact < this->level - this->hysteresis) {
+
+        bool changed = required != this->level;
+        this->level = required;
+        return changed;
+    }
+
+    return false;
+}
+
+int LevelOfDetail::getLevel() {
+
+    return this->level;
+}
+
+/**
+ * The scale the tessellations of the current level are made for.
+ */
+double LevelOfDetail::getLevelScale() {
+
+    return std::ldexp(1.0, this->level + 1);
+}
+
+/**
+ * @return the slot holding the current level, marked as the most recently
+ * used, or -1 if it is not cached.
+ */
+int LevelOfDetail::find() {
+
+    for (std::size_t i = 0; i < this->levels.size(); i++) {
+        if (this->levels[i] == this->level &&
+            this->level != LevelOfDetail::noLevel) {
+            this->uses[i] = ++this->clock;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @return the slot to store the current level into: a new one while the
+ * cache is not full, the least recently used one otherwise.
+ */
+int LevelOfDetail::insert() {
+
+    int slot = this->find();
+
+    if (slot == -1 &&
+        static_cast<int>(this->levels.size()) < this->capacity) {
+        this->levels.push_back(this->level);
+        this->uses.push_back(0);
+        slot = this->levels.size() - 1;
+    }
+    else if (slot == -1) {
+        slot = 0;
+        for (int i = 1; i < static_cast<int>(this->levels.size()); i++)
+            if (this->uses[i] < this->uses[slot]) slot = i;
+    }
+
+    this->levels[slot] = this->level;
+    this->uses[slot] = ++this->clock;
+
+    return slot;
+}
+
+/**
+ * Forgets every cached level but keeps the slots, so that their buffers are
+ * reused.
+ */
+void LevelOfDetail::clear() {
+
+    for (std::size_t i = 0; i < this->levels.size(); i++) {
+        this->levels[i] = LevelOfDetail::noLevel;
+        this->uses[i] = 0;
+    }
+}
+
+} /* namespace iphito::renderer */
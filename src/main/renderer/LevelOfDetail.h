@@ -0,0 +1,51 @@
+/**
+ * @file LevelOfDetail.h
+ * @brief Describes the zoom levels and the cache slots of tessellations
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-27
+ */
+#ifndef LEVEL_OF_DETAIL_H
+#define LEVEL_OF_DETAIL_H
+
+#include <vector>
+
+namespace iphito::renderer {
+
+/**
+ * Quantizes the pixel scale of a curve (pixels per curve unit) into levels
+ * floor(log2(scale)) and keeps track of which levels are stored in a small
+ * least recently used cache.
+ *
+ * A tessellation of level L is made for the scale 2^(L + 1), so it meets the
+ * tolerance at every scale of its level and below. The level therefore goes
+ * up as soon as the scale leaves it, but only goes down once the scale is
+ * more than the hysteresis (in levels) below it, so that zooming back and
+ * forth around a boundary does not retessellate.
+ */
+class LevelOfDetail {
+
+public:
+    LevelOfDetail(int capacity = 4, double hysteresis = 0.25);
+
+    bool update(double scale);
+    int getLevel();
+    double getLevelScale();
+    int find();
+    int insert();
+    void clear();
+
+    static constexpr int noLevel = -1000000;
+
+private:
+    int capacity;
+    double hysteresis;
+    int level;
+    unsigned long long clock;
+    std::vector<int> levels;
+    std::vector<unsigned long long> uses;
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef LEVEL_OF_DETAIL_H */
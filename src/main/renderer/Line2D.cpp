@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "Line2D.h"
+#include "ShaderRegistry.h"
 
 #include "src/main/utils/Utils.h"
 #include "src/main/utils/Logger.h"
@@ -30,15 +31,8 @@ Line2D::Line2D(const Eigen::Vector2d& startPoint,
     if(!Utils::isGlewInitialized())
         throw std::runtime_error("Please initialize Glew.");
 
-    this->shader.reset(new Shader("../src/shaders/basic.vert",
-                                  "../src/shaders/basic.frag"));
-
-    glUseProgram(this->shader->getProgramID());
-
-    int colorLocation = glGetUniformLocation(this->shader->getProgramID(),
-            "color");
-    glUniform3f(colorLocation, this->color[0], this->color[1],
-            this->color[2]);
+    this->shader = ShaderRegistry::Instance()->get(
+            "basic.vert", "basic.frag");
 
     glGenVertexArrays(1, &this->vertexArrayObjectID);
     glBindVertexArray(this->vertexArrayObjectID);
@@ -125,8 +119,7 @@ void Line2D::render() {
 
     this->shader->useProgram();
     this->shader->setMatrix4("model", this->model);
-    this->shader->setMatrix4("view", this->view);
-    this->shader->setMatrix4("projection", this->projection);
+    this->shader->setVector3("color", this->color);
 
     glBindVertexArray(this->vertexArrayObjectID);
     glDrawElements(GL_TRIANGLES, this->indices.size(), GL_UNSIGNED_INT, NULL);
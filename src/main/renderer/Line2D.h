@@ -43,7 +43,7 @@ private:
     std::vector<GLfloat> vertices;
     std::vector<GLuint> indices;
 
-    std::unique_ptr<Shader> shader;
+    std::shared_ptr<Shader> shader;
     GLuint vertexArrayObjectID;
     GLuint vertexBufferID;
     GLuint indexBufferID;
@@ -0,0 +1,118 @@
+/**
+ * @file MidpointSampler.cpp
+ * @brief Implements a sampler recursively splitting a curve at random
+ * midpoints
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-06
+ */
+#include <array>
+#include <bit>
+#include <cmath>
+
+#include "MidpointSampler.h"
+#include "src/main/utils/Utils.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::math;
+using namespace iphito::utils;
+
+void MidpointSampler::sample(Curve& curve, const Eigen::Matrix4d& transform,
+                             double tolerance, unsigned long long seed,
+                             double a, double b,
+                             std::vector<double>& parameters,
+                             std::vector<Eigen::Vector2d>& points) {
+
+    this->sampleCurve(curve, transform, tolerance, seed, a, b, 0, parameters,
+                      points);
+}
+
+void MidpointSampler::sampleCurve(Curve& curve,
+                                  const Eigen::Matrix4d& transform,
+                                  double tolerance, unsigned long long seed,
+                                  double a, double b, int depth,
+                                  std::vector<double>& parameters,
+                                  std::vector<Eigen::Vector2d>& points) {
+
+    const unsigned long long interval = Utils::hash(
+            std::bit_cast<unsigned long long>(a),
+            std::bit_cast<unsigned long long>(b));
+    double t = 0.45 + 0.1 * Utils::uniform(seed, interval);
+    double m = a + t * (b - a);
+
+    Eigen::Vector4d pa3D;
+    Eigen::Vector4d pb3D;
+    Eigen::Vector4d pm3D;
+    const std::array<double, 3> samples = {a, b, m};
+    std::array<Eigen::Vector2d, 3> samplePoints;
+    curve.evaluateAt(samples, samplePoints);
+
+    Eigen::Vector2d pa = samplePoints[0];
+    Eigen::Vector2d pb = samplePoints[1];
+
+    pa3D << samplePoints[0], 1.0, 0.0;
+    pb3D << samplePoints[1], 1.0, 0.0;
+    pm3D << samplePoints[2], 1.0, 0.0;
+
+    pa3D = transform * pa3D;
+    pb3D = transform * pb3D;
+    pm3D = transform * pm3D;
+    Eigen::Vector2d paScreen;
+    Eigen::Vector2d pbScreen;
+    Eigen::Vector2d pmScreen;
+    paScreen << pa3D[0], pa3D[1];
+    pbScreen << pb3D[0], pb3D[1];
+    pmScreen << pm3D[0], pm3D[1];
+
+
+    if(depth >= MidpointSampler::maximumDepth ||
+       isFlat(paScreen, pbScreen, pmScreen, tolerance)) {
+        if(!points.empty()) {
+            Eigen::Vector2d back = points.back();
+            if(!(Utils::nearlyEqual(back[0], pa[0]) && 
+                 Utils::nearlyEqual(back[1], pa[1]))) {
+
+                points.push_back(pa);
+                points.push_back(pb);
+                parameters.push_back(a);
+                parameters.push_back(b);
+            }
+            else {
+                points.push_back(pb);
+                parameters.push_back(b);
+            }
+        }
+        else {
+            points.push_back(pa);
+            points.push_back(pb);
+            parameters.push_back(a);
+            parameters.push_back(b);
+        }
+    }
+    else{
+        sampleCurve(curve, transform, tolerance, seed, a, m, depth + 1,
+                    parameters, points);
+        sampleCurve(curve, transform, tolerance, seed, m, b, depth + 1,
+                    parameters, points);
+    }
+}
+
+/**
+ * An interval is flat when its split point deviates from the chord by at most
+ * the tolerance, i.e. when drawing the chord is off by less than that many
+ * pixels.
+ */
+bool MidpointSampler::isFlat(Eigen::Vector2d a, Eigen::Vector2d b,
+                             Eigen::Vector2d m, double tolerance) {
+
+    Eigen::Vector2d ab = b - a;
+    Eigen::Vector2d am = m - a;
+    double length = ab.norm();
+
+    if (length == 0.0) return am.norm() <= tolerance;
+
+    return std::abs(ab[0] * am[1] - ab[1] * am[0]) / length <= tolerance;
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,51 @@
+/**
+ * @file MidpointSampler.h
+ * @brief Describes a sampler recursively splitting a curve at random
+ * midpoints
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-06
+ */
+#ifndef MIDPOINT_SAMPLER_H
+#define MIDPOINT_SAMPLER_H
+
+#include <vector>
+#include <Eigen/Core>
+
+#include "Sampler.h"
+
+namespace iphito::renderer {
+
+/**
+ * Splits every interval close to its middle until the split point lies within
+ * the tolerance of the chord in screen space. The split point is jittered so
+ * that symmetric curves are not mistaken for lines. The jitter is a hash of
+ * the seed and of the interval. The recursion stops at the maximum depth
+ * whatever the tolerance, e.g. for a degenerate transform.
+ */
+class MidpointSampler : public Sampler {
+
+public:
+    using Sampler::sample;
+    void sample(iphito::math::Curve& curve, const Eigen::Matrix4d& transform,
+                double tolerance, unsigned long long seed, double a, double b,
+                std::vector<double>& parameters,
+                std::vector<Eigen::Vector2d>& points) override;
+
+    /* Largest number of splits of an interval, bounding it to 4096 segments
+     * as the WangFlattener. */
+    static constexpr int maximumDepth = 12;
+
+private:
+    void sampleCurve(iphito::math::Curve& curve,
+                     const Eigen::Matrix4d& transform, double tolerance,
+                     unsigned long long seed, double a, double b, int depth,
+                     std::vector<double>& parameters,
+                     std::vector<Eigen::Vector2d>& points);
+    bool isFlat(Eigen::Vector2d a, Eigen::Vector2d b, Eigen::Vector2d m,
+                double tolerance);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef MIDPOINT_SAMPLER_H */
@@ -9,15 +9,18 @@
 #define POINT2D_H
 
 #include <memory>
-#include <random>
-#include <vector>
 #include <Eigen/Core>
-#include <GL/glew.h>
 
-#include "Shader.h"
+#include "InstancedOverlay.h"
 
 namespace iphito::renderer {
 
+/**
+ * A disc drawn as a single quad, whose coverage is computed from the signed
+ * distance to its circle in the fragment shader. Nothing is tessellated on
+ * the CPU, whatever the zoom. A positive width draws a ring of that
+ * thickness around the circle instead.
+ */
 class Point2D {
 
 public:
@@ -33,30 +36,13 @@ public:
     void updateProjectionMatrix(const Eigen::Matrix4d& projection);
 
 private:
-    Eigen::Vector3d center;
+    Eigen::Vector2d center;
     Eigen::Vector3d color;
     double radius;
     double width;
     Eigen::Matrix4d model;
-    Eigen::Matrix4d view;
-    Eigen::Matrix4d projection;
-    bool isDirty;
-    
-    std::unique_ptr<Shader> shader;
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-    GLuint vertexArrayObjectID;
-    GLuint vertexBufferID;
-    GLuint indexBufferID;
-    std::vector<Eigen::Vector2d> samplePoints;
-
-    static std::mt19937_64 engine;
-    static std::uniform_real_distribution<double> distribution;
 
-    void sampleCurve(double a, double b);
-    bool isFlat(Eigen::Vector2d a, Eigen::Vector2d b, Eigen::Vector2d m);
-    Eigen::Vector2d evaluateCircleAt(double t);
-    void recomputeVerticesAndIndices();
+    std::unique_ptr<InstancedOverlay> disc;
 };
 
 } /* namespace iphito::renderer */
@@ -0,0 +1,111 @@
+/**
+ * @file RangeAllocator.cpp
+ * @brief Implements the allocation of ranges of a buffer from a free list
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-29
+ */
+#include <iterator>
+#include <stdexcept>
+
+#include "RangeAllocator.h"
+
+namespace iphito::renderer {
+
+RangeAllocator::RangeAllocator(std::size_t capacity) : capacity{0}, used{0} {
+
+    this->grow(capacity);
+}
+
+/**
+ * @return the offset of a range of the given size, or noOffset if no free
+ * range is large enough.
+ */
+std::ptrdiff_t RangeAllocator::allocate(std::size_t size) {
+
+    if (size == 0)
+        throw std::domain_error("An empty range cannot be allocated.");
+
+    for (auto i = this->freeRanges.begin(); i != this->freeRanges.end(); i++) {
+
+        if (i->second < size) continue;
+
+        std::size_t offset = i->first;
+        std::size_t remaining = i->second - size;
+        this->freeRanges.erase(i);
+
+        if (remaining > 0)
+            this->freeRanges.insert({offset + size, remaining});
+
+        this->used += size;
+        return offset;
+    }
+
+    return RangeAllocator::noOffset;
+}
+
+void RangeAllocator::release(std::size_t offset, std::size_t size) {
+
+    if (size == 0) return;
+
+    if (offset + size > this->capacity)
+        throw std::out_of_range("The range is outside of the buffer.");
+
+    this->insertFreeRange(offset, size);
+    this->used -= size;
+}
+
+/**
+ * Extends the buffer to the capacity, the new space being free.
+ */
+void RangeAllocator::grow(std::size_t capacity) {
+
+    if (capacity <= this->capacity) return;
+
+    std::size_t previous = this->capacity;
+    this->capacity = capacity;
+    this->insertFreeRange(previous, capacity - previous);
+}
+
+std::size_t RangeAllocator::getCapacity() {
+
+    return this->capacity;
+}
+
+std::size_t RangeAllocator::getUsed() {
+
+    return this->used;
+}
+
+/**
+ * Adds a free range, merged with the free ranges right before and after it.
+ */
+void RangeAllocator::insertFreeRange(std::size_t offset, std::size_t size) {
+
+    auto next = this->freeRanges.lower_bound(offset);
+
+    if (next != this->freeRanges.end() && next->first < offset + size)
+        throw std::invalid_argument("The range is not allocated.");
+
+    if (next != this->freeRanges.begin()) {
+        auto previous = std::prev(next);
+
+        if (previous->first + previous->second > offset)
+            throw std::invalid_argument("The range is not allocated.");
+
+        if (previous->first + previous->second == offset) {
+            offset = previous->first;
+            size += previous->second;
+            this->freeRanges.erase(previous);
+        }
+    }
+
+    if (next != this->freeRanges.end() && next->first == offset + size) {
+        size += next->second;
+        this->freeRanges.erase(next);
+    }
+
+    this->freeRanges.insert({offset, size});
+}
+
+} /* namespace iphito::renderer */
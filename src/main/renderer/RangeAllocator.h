@@ -0,0 +1,49 @@
+/**
+ * @file RangeAllocator.h
+ * @brief Describes the allocation of ranges of a buffer from a free list
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-29
+ */
+#ifndef RANGE_ALLOCATOR_H
+#define RANGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <map>
+
+namespace iphito::renderer {
+
+/**
+ * Hands out ranges of a buffer of a given capacity, in any unit (bytes,
+ * vertices, indices...). The free ranges are kept sorted by offset and merged
+ * with their neighbours when released, and a range is allocated from the
+ * first free range large enough. The allocator only does the bookkeeping, the
+ * storage itself belongs to the caller.
+ */
+class RangeAllocator {
+
+public:
+    RangeAllocator(std::size_t capacity = 0);
+
+    std::ptrdiff_t allocate(std::size_t size);
+    void release(std::size_t offset, std::size_t size);
+    void grow(std::size_t capacity);
+    std::size_t getCapacity();
+    std::size_t getUsed();
+
+    /* Returned when no free range is large enough. */
+    static constexpr std::ptrdiff_t noOffset = -1;
+
+private:
+    std::size_t capacity;
+    std::size_t used;
+
+    /* Size of every free range, by offset. */
+    std::map<std::size_t, std::size_t> freeRanges;
+
+    void insertFreeRange(std::size_t offset, std::size_t size);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef RANGE_ALLOCATOR_H */
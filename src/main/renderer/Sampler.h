@@ -0,0 +1,60 @@
+/**
+ * @file Sampler.h
+ * @brief Describes a strategy choosing the points at which a curve is sampled
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-06
+ */
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <vector>
+#include <Eigen/Core>
+
+#include "src/main/math/Curve.h"
+
+namespace iphito::renderer {
+
+/**
+ * A sampler turns a curve into a polyline for a given transform from the
+ * curve space to the screen space in pixels (viewport * projection * view *
+ * model). The polyline stays within tolerance pixels of the curve over the
+ * parameter interval [a, b]. Its parameters and points are appended to the
+ * outputs, ordered by increasing parameter and starting at a and ending at b.
+ *
+ * Samplers taking randomized decisions derive them from the seed only, so the
+ * output is reproducible and a sampler can be shared between threads.
+ */
+class Sampler {
+
+public:
+    virtual ~Sampler() = 0;
+    virtual void sample(iphito::math::Curve& curve,
+                        const Eigen::Matrix4d& transform, double tolerance,
+                        unsigned long long seed, double a, double b,
+                        std::vector<double>& parameters,
+                        std::vector<Eigen::Vector2d>& points) = 0;
+
+    void sample(iphito::math::Curve& curve, const Eigen::Matrix4d& transform,
+                double tolerance, unsigned long long seed,
+                std::vector<double>& parameters,
+                std::vector<Eigen::Vector2d>& points);
+};
+
+inline Sampler::~Sampler() {}
+
+/**
+ * Samples the whole curve, i.e. the interval [0, 1].
+ */
+inline void Sampler::sample(iphito::math::Curve& curve,
+                            const Eigen::Matrix4d& transform,
+                            double tolerance, unsigned long long seed,
+                            std::vector<double>& parameters,
+                            std::vector<Eigen::Vector2d>& points) {
+    this->sample(curve, transform, tolerance, seed, 0.0, 1.0, parameters,
+                 points);
+}
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef SAMPLER_H */
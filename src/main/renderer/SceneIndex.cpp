@@ -0,0 +1,62 @@
+/**
+ * @file SceneIndex.cpp
+ * @brief Implements the index of the curves and layers of a layer tree
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-22
+ */
+#include "SceneIndex.h"
+
+namespace iphito::renderer {
+
+SceneIndex::SceneIndex() {}
+
+void SceneIndex::insertCurve(unsigned long long id, Layer* owner) {
+
+    this->curveOwners[id] = owner;
+}
+
+void SceneIndex::insertLayer(unsigned long long id, Layer* layer) {
+
+    this->layers[id] = layer;
+}
+
+void SceneIndex::eraseCurve(unsigned long long id) {
+
+    this->curveOwners.erase(id);
+}
+
+void SceneIndex::eraseLayer(unsigned long long id) {
+
+    this->layers.erase(id);
+}
+
+/**
+ * The layer owning the curve, or nullptr when the curve is not in the tree.
+ */
+Layer* SceneIndex::findCurveOwner(unsigned long long id) {
+
+    auto i = this->curveOwners.find(id);
+    return i == this->curveOwners.end() ? nullptr : i->second;
+}
+
+/**
+ * The layer with the identifier, or nullptr when it is not in the tree.
+ */
+Layer* SceneIndex::findLayer(unsigned long long id) {
+
+    auto i = this->layers.find(id);
+    return i == this->layers.end() ? nullptr : i->second;
+}
+
+/**
+ * Adds the entries of the index of a tree grafted onto this one.
+ */
+void SceneIndex::merge(const SceneIndex& index) {
+
+    this->curveOwners.insert(index.curveOwners.begin(),
+                             index.curveOwners.end());
+    this->layers.insert(index.layers.begin(), index.layers.end());
+}
+
+} /* namespace iphito::renderer */
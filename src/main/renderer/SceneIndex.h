@@ -0,0 +1,43 @@
+/**
+ * @file SceneIndex.h
+ * @brief Describes the index of the curves and layers of a layer tree
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-22
+ */
+#ifndef SCENE_INDEX_H
+#define SCENE_INDEX_H
+
+#include <unordered_map>
+
+namespace iphito::renderer {
+
+class Layer;
+
+/**
+ * Maps the identifier of every curve of a layer tree to the layer owning it,
+ * and the identifier of every layer of the tree to the layer itself. All the
+ * layers of a tree share the index of its root, so finding where a curve or
+ * a layer lives takes constant time whatever the size of the tree.
+ */
+class SceneIndex {
+
+public:
+    SceneIndex();
+
+    void insertCurve(unsigned long long id, Layer* owner);
+    void insertLayer(unsigned long long id, Layer* layer);
+    void eraseCurve(unsigned long long id);
+    void eraseLayer(unsigned long long id);
+    Layer* findCurveOwner(unsigned long long id);
+    Layer* findLayer(unsigned long long id);
+    void merge(const SceneIndex& index);
+
+private:
+    std::unordered_map<unsigned long long, Layer*> curveOwners;
+    std::unordered_map<unsigned long long, Layer*> layers;
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef SCENE_INDEX_H */
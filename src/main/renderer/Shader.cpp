@@ -5,6 +5,11 @@
  * @version 0.1.0
  * @date 2018-11-21
  */
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -12,6 +17,8 @@
 #include <GL/glew.h>
 
 #include "Shader.h"
+#include "CameraUniformBuffer.h"
+#include "ShaderSources.h"
 
 #include "src/main/utils/Utils.h"
 #include "src/main/utils/Logger.h"
@@ -20,29 +27,66 @@ namespace iphito::renderer {
 
 using namespace iphito::utils;
 
-Shader::Shader(std::string vertexShaderPath, std::string fragmentShaderPath) {
+/**
+ * Builds the program from the embedded sources of the given names. When a
+ * binary cache directory is given and the driver supports program binaries,
+ * the linked program is stored there and reloaded on the next start instead
+ * of being compiled again. The cache entries are keyed by the driver strings
+ * and the sources, so a driver update or a shader change misses the cache.
+ * The file name is only a hash of the key, the entry holding the key itself.
+ */
+Shader::Shader(const std::string& vertexShaderName,
+               const std::string& fragmentShaderName,
+               const std::string& binaryCacheDirectory) :
+    vertexShaderName{vertexShaderName},
+    fragmentShaderName{fragmentShaderName} {
 
     if(!Utils::isGlfwInitialized())
         throw std::runtime_error("Please initialize GLFW.");
 
     if(!Utils::isGlewInitialized())
         throw std::runtime_error("Please initialize Glew.");
-    
+
+    const std::string& vertexShaderCode =
+        ShaderSources::get(vertexShaderName);
+    const std::string& fragmentShaderCode =
+        ShaderSources::get(fragmentShaderName);
+
+    this->shaderProgramID = glCreateProgram();
+
+    std::string cacheKey;
+    std::string cachePath;
+    if(!binaryCacheDirectory.empty() && GLEW_ARB_get_program_binary) {
+        cacheKey = this->binaryCacheKey(vertexShaderCode, fragmentShaderCode);
+        cachePath = this->binaryCachePath(binaryCacheDirectory, cacheKey);
+
+        if(this->loadProgramBinary(cachePath, cacheKey)) {
+            this->bindUniformBlocks();
+            return;
+        }
+
+        glProgramParameteri(this->shaderProgramID,
+                            GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
 
     this->vertexShaderID = glCreateShader(GL_VERTEX_SHADER);
     this->fragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
 
-    std::string vertexShaderCode = Utils::readFile(vertexShaderPath);
-    std::string fragmentShaderCode = Utils::readFile(fragmentShaderPath);
-
     this->compileShader(vertexShaderID, vertexShaderCode, "vertex shader (" +
-                        vertexShaderPath + ")");
+                        vertexShaderName + ")");
     this->compileShader(fragmentShaderID, fragmentShaderCode, "fragment shader"
-                        " (" + fragmentShaderPath + ")");
+                        " (" + fragmentShaderName + ")");
+
+    this->linkProgram();
+    this->bindUniformBlocks();
+
+    if(!cachePath.empty()) this->saveProgramBinary(cachePath, cacheKey);
+}
+
+void Shader::linkProgram() {
 
     Logger::Instance()->info("Linking program");
 
-    this->shaderProgramID = glCreateProgram();
     glAttachShader(this->shaderProgramID, this->vertexShaderID);
     glAttachShader(this->shaderProgramID, this->fragmentShaderID);
     glLinkProgram(this->shaderProgramID);
@@ -76,6 +120,129 @@ Shader::Shader(std::string vertexShaderPath, std::string fragmentShaderPath) {
     glDeleteShader(this->fragmentShaderID);
 }
 
+/**
+ * Uniform block bindings are not part of the program binary and GLSL 4.1 has
+ * no binding layout qualifier, so they are set after every link or load.
+ */
+void Shader::bindUniformBlocks() {
+
+    GLuint cameraIndex = glGetUniformBlockIndex(this->shaderProgramID,
+            CameraUniformBuffer::blockName);
+
+    if(cameraIndex != GL_INVALID_INDEX)
+        glUniformBlockBinding(this->shaderProgramID, cameraIndex,
+                              CameraUniformBuffer::bindingPoint);
+}
+
+std::string Shader::binaryCacheKey(const std::string& vertexShaderCode,
+                                   const std::string& fragmentShaderCode) {
+
+    std::stringstream key;
+    key << glGetString(GL_VENDOR) << '\n' << glGetString(GL_RENDERER) << '\n'
+        << glGetString(GL_VERSION) << '\n' << vertexShaderCode << '\n'
+        << fragmentShaderCode;
+
+    return key.str();
+}
+
+/**
+ * Distinct keys may share a path, their entries then replacing each other.
+ */
+std::string Shader::binaryCachePath(const std::string& binaryCacheDirectory,
+                                    const std::string& key) {
+
+    std::stringstream fileName;
+    fileName << std::hex << std::hash<std::string>{}(key) << ".bin";
+
+    return (std::filesystem::path(binaryCacheDirectory) /
+            fileName.str()).string();
+}
+
+/**
+ * A cache entry holds the length of the key, the key, the binary format and
+ * the program binary.
+ *
+ * @return whether the program was restored from the entry. An entry of
+ * another key or which the driver rejects is not an error.
+ */
+bool Shader::loadProgramBinary(const std::string& path,
+                               const std::string& key) {
+
+    if(!std::filesystem::exists(path)) return false;
+
+    std::string binary;
+    try {
+        binary = Utils::readFile(path);
+    }
+    catch(std::exception& e) {
+        return false;
+    }
+
+    std::uint64_t keyLength = 0;
+    const std::size_t headerLength = sizeof(keyLength) + key.size() +
+                                     sizeof(GLenum);
+
+    if(binary.size() <= headerLength) return false;
+
+    std::memcpy(&keyLength, binary.data(), sizeof(keyLength));
+
+    if(keyLength != key.size() ||
+       binary.compare(sizeof(keyLength), key.size(), key) != 0) {
+        Logger::Instance()->info("Program binary of another key: " + path);
+        return false;
+    }
+
+    GLenum format = 0;
+    std::memcpy(&format, binary.data() + sizeof(keyLength) + key.size(),
+                sizeof(GLenum));
+    glProgramBinary(this->shaderProgramID, format,
+                    binary.data() + headerLength,
+                    binary.size() - headerLength);
+
+    GLint linkStatus = 0;
+    glGetProgramiv(this->shaderProgramID, GL_LINK_STATUS, &linkStatus);
+
+    if(linkStatus == GL_FALSE) {
+        Logger::Instance()->info("Program binary rejected: " + path);
+        return false;
+    }
+
+    Logger::Instance()->info("Loaded program binary: " + path);
+    return true;
+}
+
+void Shader::saveProgramBinary(const std::string& path,
+                               const std::string& key) {
+
+    GLint length = 0;
+    glGetProgramiv(this->shaderProgramID, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if(length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(this->shaderProgramID, length, NULL, &format,
+                       binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(
+            std::filesystem::path(path).parent_path(), error);
+
+    std::ofstream fileStream(path, std::ios::out | std::ios::binary);
+
+    if(!fileStream.is_open()) {
+        Logger::Instance()->warn("Cannot write program binary: " + path);
+        return;
+    }
+
+    const std::uint64_t keyLength = key.size();
+    fileStream.write(reinterpret_cast<const char*>(&keyLength),
+                     sizeof(keyLength));
+    fileStream.write(key.data(), key.size());
+    fileStream.write(reinterpret_cast<const char*>(&format), sizeof(GLenum));
+    fileStream.write(binary.data(), binary.size());
+}
+
 Shader::~Shader() {
 
     /* glDetachShader(this->shaderProgramID, this->vertexShaderID); */
@@ -88,10 +255,41 @@ Shader::~Shader() {
 void Shader::setMatrix4(const std::string& name,
                         const Eigen::Matrix4d& matrix) {
 
-    int matrixLocation = glGetUniformLocation(this->shaderProgramID,
-                                              name.c_str());
     Eigen::Matrix4f m = matrix.cast<float>();
-    glUniformMatrix4fv(matrixLocation, 1, GL_FALSE, m.data());
+    glUniformMatrix4fv(this->getUniformLocation(name), 1, GL_FALSE, m.data());
+}
+
+void Shader::setVector3(const std::string& name,
+                        const Eigen::Vector3d& vector) {
+
+    glUniform3f(this->getUniformLocation(name), vector[0], vector[1],
+                vector[2]);
+}
+
+void Shader::setFloat(const std::string& name, double value) {
+
+    glUniform1f(this->getUniformLocation(name), value);
+}
+
+void Shader::setBool(const std::string& name, bool value) {
+
+    glUniform1i(this->getUniformLocation(name), value);
+}
+
+/**
+ * Uniform locations are fixed once the program is linked, so each name is
+ * only resolved on its first use.
+ */
+GLint Shader::getUniformLocation(const std::string& name) {
+
+    auto i = this->uniformLocations.find(name);
+
+    if(i != this->uniformLocations.end()) return i->second;
+
+    GLint location = glGetUniformLocation(this->shaderProgramID, name.c_str());
+    this->uniformLocations[name] = location;
+
+    return location;
 }
 
 GLuint Shader::getProgramID() {
@@ -104,7 +302,7 @@ void Shader::useProgram() {
     glUseProgram(this->shaderProgramID);
 }
 
-void Shader::compileShader(GLuint& shaderID, std::string& shaderCode, 
+void Shader::compileShader(GLuint& shaderID, const std::string& shaderCode, 
                            std::string logInfo) {
 
     Logger::Instance()->info("Compiling shader: " + logInfo);
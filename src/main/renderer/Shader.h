@@ -9,6 +9,7 @@
 #define SHADER_H value
 
 #include <string>
+#include <unordered_map>
 #include <GL/glew.h>
 #include <Eigen/Core>
 
@@ -19,11 +20,17 @@ class Shader {
 public:
 
     Shader() = delete;
-    Shader(std::string vertexShaderPath, std::string fragmentShaderPath);
+    Shader(const std::string& vertexShaderName,
+           const std::string& fragmentShaderName,
+           const std::string& binaryCacheDirectory = "");
     ~Shader();
 
     void setMatrix4(const std::string& name, const Eigen::Matrix4d& matrix);
+    void setVector3(const std::string& name, const Eigen::Vector3d& vector);
+    void setFloat(const std::string& name, double value);
+    void setBool(const std::string& name, bool value);
 
+    GLint getUniformLocation(const std::string& name);
     GLuint getProgramID();
     void useProgram();
     
@@ -33,11 +40,20 @@ private:
     GLuint vertexShaderID;
     GLuint fragmentShaderID;
 
-    std::string vertexShaderPath;
-    std::string fragmentShaderPath;
+    std::string vertexShaderName;
+    std::string fragmentShaderName;
+    std::unordered_map<std::string, GLint> uniformLocations;
 
-    void compileShader(GLuint& shaderID, std::string& shaderCode,
+    void compileShader(GLuint& shaderID, const std::string& shaderCode,
                        std::string logInfo = "");
+    void linkProgram();
+    void bindUniformBlocks();
+    std::string binaryCacheKey(const std::string& vertexShaderCode,
+                               const std::string& fragmentShaderCode);
+    std::string binaryCachePath(const std::string& binaryCacheDirectory,
+                                const std::string& key);
+    bool loadProgramBinary(const std::string& path, const std::string& key);
+    void saveProgramBinary(const std::string& path, const std::string& key);
 };
 
 } /* namespace iphito::renderer */
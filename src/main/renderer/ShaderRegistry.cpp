@@ -0,0 +1,55 @@
+/**
+ * @file ShaderRegistry.cpp
+ * @brief Implements the ShaderRegistry singleton
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-03
+ */
+#include "ShaderRegistry.h"
+
+namespace iphito::renderer {
+
+std::shared_ptr<ShaderRegistry> ShaderRegistry::instance = nullptr;
+
+std::shared_ptr<ShaderRegistry>& ShaderRegistry::Instance() {
+
+    if(!ShaderRegistry::instance)
+        ShaderRegistry::instance.reset(new ShaderRegistry());
+
+    return ShaderRegistry::instance;
+}
+
+ShaderRegistry::ShaderRegistry() {}
+
+ShaderRegistry::~ShaderRegistry() {}
+
+/**
+ * @return the program linked from the given shaders, built on first use.
+ */
+std::shared_ptr<Shader> ShaderRegistry::get(
+        const std::string& vertexShaderName,
+        const std::string& fragmentShaderName) {
+
+    auto key = std::make_pair(vertexShaderName, fragmentShaderName);
+    auto i = this->shaders.find(key);
+
+    if (i != this->shaders.end()) return i->second;
+
+    std::shared_ptr<Shader> shader = std::make_shared<Shader>(
+            vertexShaderName, fragmentShaderName, this->binaryCacheDirectory);
+    this->shaders[key] = shader;
+
+    return shader;
+}
+
+/**
+ * Enables the on-disk cache of the programs built from now on. An empty
+ * directory disables it.
+ */
+void ShaderRegistry::setBinaryCacheDirectory(
+        const std::string& binaryCacheDirectory) {
+
+    this->binaryCacheDirectory = binaryCacheDirectory;
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,51 @@
+/**
+ * @file ShaderRegistry.h
+ * @brief Describes the ShaderRegistry singleton
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-03
+ */
+#ifndef SHADER_REGISTRY_H
+#define SHADER_REGISTRY_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "Shader.h"
+
+namespace iphito::renderer {
+
+/**
+ * Compiles and links every shader program once and shares it between all the
+ * objects drawn with it. Per object state, like the color, is set as
+ * uniforms at draw time. Has to be used from the thread owning the GL
+ * context.
+ */
+class ShaderRegistry {
+
+public:
+
+    ~ShaderRegistry();
+
+    static std::shared_ptr<ShaderRegistry>& Instance();
+
+    std::shared_ptr<Shader> get(const std::string& vertexShaderName,
+                                const std::string& fragmentShaderName);
+    void setBinaryCacheDirectory(const std::string& binaryCacheDirectory);
+
+private:
+    ShaderRegistry();
+    ShaderRegistry(const ShaderRegistry& r) = delete;
+    ShaderRegistry& operator=(const ShaderRegistry& r) = delete;
+
+    static std::shared_ptr<ShaderRegistry> instance;
+    std::map<std::pair<std::string, std::string>,
+             std::shared_ptr<Shader>> shaders;
+    std::string binaryCacheDirectory;
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef SHADER_REGISTRY_H */
@@ -0,0 +1,46 @@
+/**
+ * @file ShaderSources.cpp
+ * @brief Implements the lookup of the shader sources embedded at build time
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-03
+ */
+#include <map>
+#include <stdexcept>
+
+#include "ShaderSources.h"
+
+/* Generated from src/shaders by src/shaders/embed_shader.py. */
+#include "basic.frag.h"
+#include "basic.vert.h"
+#include "grid.frag.h"
+#include "grid.vert.h"
+#include "overlay.frag.h"
+#include "overlay.vert.h"
+#include "point.frag.h"
+#include "stroke.vert.h"
+
+namespace iphito::renderer {
+
+const std::string& ShaderSources::get(const std::string& name) {
+
+    static const std::map<std::string, std::string> sources = {
+        {"basic.frag", iphito::shaders::basic_frag},
+        {"basic.vert", iphito::shaders::basic_vert},
+        {"grid.frag", iphito::shaders::grid_frag},
+        {"grid.vert", iphito::shaders::grid_vert},
+        {"overlay.frag", iphito::shaders::overlay_frag},
+        {"overlay.vert", iphito::shaders::overlay_vert},
+        {"point.frag", iphito::shaders::point_frag},
+        {"stroke.vert", iphito::shaders::stroke_vert},
+    };
+
+    auto i = sources.find(name);
+
+    if (i == sources.end())
+        throw std::invalid_argument("Unknown shader: " + name);
+
+    return i->second;
+}
+
+} /* namespace iphito::renderer */
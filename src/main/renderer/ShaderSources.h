@@ -0,0 +1,28 @@
+/**
+ * @file ShaderSources.h
+ * @brief Describes the lookup of the shader sources embedded at build time
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-03
+ */
+#ifndef SHADER_SOURCES_H
+#define SHADER_SOURCES_H
+
+#include <string>
+
+namespace iphito::renderer {
+
+/**
+ * The GLSL sources of src/shaders are compiled into the executable, so that
+ * it does not depend on the working directory. They are looked up by file
+ * name, e.g. "basic.vert".
+ */
+class ShaderSources {
+
+public:
+    static const std::string& get(const std::string& name);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef SHADER_SOURCES_H */
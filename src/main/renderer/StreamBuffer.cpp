@@ -0,0 +1,180 @@
+/**
+ * @file StreamBuffer.cpp
+ * @brief Implements a ring buffer streaming data to the GPU
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-01
+ */
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+#include "StreamBuffer.h"
+
+#include "src/main/utils/Utils.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::utils;
+
+StreamBuffer::StreamBuffer(GLsizeiptr capacity) : bufferID{0}, capacity{0},
+    head{0}, offset{0}, isPersistent{GLEW_ARB_buffer_storage != 0},
+    memory{nullptr} {
+
+    if(!Utils::isGlfwInitialized())
+        throw std::runtime_error("Please initialize GLFW.");
+
+    if(!Utils::isGlewInitialized())
+        throw std::runtime_error("Please initialize Glew.");
+
+    if (capacity <= 0)
+        throw std::invalid_argument("The capacity has to be positive.");
+
+    this->allocate(capacity);
+}
+
+StreamBuffer::~StreamBuffer() {
+
+    this->release();
+}
+
+/**
+ * Gives out the next range of the given size to write to. It has to be
+ * unmapped before any command uses the buffer.
+ */
+void* StreamBuffer::map(GLsizeiptr size) {
+
+    if (size > this->capacity / 2)
+        this->allocate(std::max(2 * size, 2 * this->capacity));
+
+    GLintptr start = (this->head + StreamBuffer::alignment - 1) /
+                     StreamBuffer::alignment * StreamBuffer::alignment;
+    bool isWrapping = start + size > this->capacity;
+    if (isWrapping) start = 0;
+
+    this->offset = start;
+    this->head = start + size;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->bufferID);
+
+    if (this->isPersistent) {
+        /* The commands issued so far are the last ones which may read the
+         * previous range. */
+        if (!this->ranges.empty() && this->ranges.back().fence == nullptr) {
+            this->ranges.back().fence = glFenceSync(
+                    GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+
+        this->waitFor(start, start + size);
+        this->ranges.push_back({start, start + size, nullptr});
+
+        return this->memory + start;
+    }
+
+    if (isWrapping) {
+        glBufferData(GL_COPY_WRITE_BUFFER, this->capacity, NULL,
+                     GL_STREAM_DRAW);
+    }
+
+    return glMapBufferRange(GL_COPY_WRITE_BUFFER, start, size,
+                            GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT |
+                            GL_MAP_INVALIDATE_RANGE_BIT);
+}
+
+/**
+ * Ends the writing of the range given out last and returns its offset in the
+ * buffer.
+ */
+GLintptr StreamBuffer::unmap() {
+
+    if (!this->isPersistent) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, this->bufferID);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return this->offset;
+}
+
+/**
+ * The identifier changes when the buffer grows.
+ */
+GLuint StreamBuffer::getBufferID() {
+
+    return this->bufferID;
+}
+
+/**
+ * Replaces the storage with a new one. Immutable storage cannot be resized, so
+ * a new buffer is created in any case.
+ */
+void StreamBuffer::allocate(GLsizeiptr capacity) {
+
+    this->release();
+
+    this->capacity = capacity;
+    this->head = 0;
+    this->offset = 0;
+
+    glGenBuffers(1, &this->bufferID);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, this->bufferID);
+
+    if (this->isPersistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                                 GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, capacity, NULL, flags);
+        this->memory = static_cast<char*>(glMapBufferRange(
+                    GL_COPY_WRITE_BUFFER, 0, capacity, flags));
+    }
+    else {
+        glBufferData(GL_COPY_WRITE_BUFFER, capacity, NULL, GL_STREAM_DRAW);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamBuffer::release() {
+
+    for (auto& i : this->ranges) {
+        if (i.fence != nullptr) glDeleteSync(i.fence);
+    }
+    this->ranges.clear();
+
+    if (this->bufferID == 0) return;
+
+    if (this->isPersistent) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, this->bufferID);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        this->memory = nullptr;
+    }
+
+    glDeleteBuffers(1, &this->bufferID);
+    this->bufferID = 0;
+}
+
+/**
+ * Waits until the GPU no longer reads the ranges overlapping [start, end).
+ */
+void StreamBuffer::waitFor(GLintptr start, GLintptr end) {
+
+    for (auto i = this->ranges.begin(); i != this->ranges.end();) {
+
+        if (i->end <= start || end <= i->start) {
+            i++;
+            continue;
+        }
+
+        GLenum status = GL_TIMEOUT_EXPIRED;
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(i->fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                      UINT64_MAX);
+        }
+
+        glDeleteSync(i->fence);
+        i = this->ranges.erase(i);
+    }
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,65 @@
+/**
+ * @file StreamBuffer.h
+ * @brief Describes a ring buffer streaming data to the GPU
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-05-01
+ */
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#include <deque>
+#include <GL/glew.h>
+
+namespace iphito::renderer {
+
+/**
+ * A buffer written in turn from its start to its end and again, so that data
+ * is uploaded by writing it directly to mapped memory, without going through
+ * an intermediate copy nor reallocating the storage when the sizes vary.
+ *
+ * With GL_ARB_buffer_storage the whole buffer is mapped once, persistently and
+ * coherently. A range is then written only once the GPU is done with the
+ * commands issued before it was last given out, which a fence tells. Without
+ * it, every range is mapped unsynchronized, and the storage is orphaned when
+ * writing wraps around to the start.
+ *
+ * A range stays valid until the next one is given out, which never overlaps
+ * it. The buffer only grows, when a range larger than half of it is asked for.
+ */
+class StreamBuffer {
+
+public:
+    StreamBuffer(GLsizeiptr capacity);
+    ~StreamBuffer();
+
+    void* map(GLsizeiptr size);
+    GLintptr unmap();
+    GLuint getBufferID();
+
+    /* Alignment of the offsets of the ranges, GL_MIN_MAP_BUFFER_ALIGNMENT. */
+    static constexpr GLsizeiptr alignment = 64;
+
+private:
+    struct Range {
+        GLintptr start;
+        GLintptr end;
+        GLsync fence;
+    };
+
+    GLuint bufferID;
+    GLsizeiptr capacity;
+    GLintptr head;
+    GLintptr offset;
+    bool isPersistent;
+    char* memory;
+    std::deque<Range> ranges;
+
+    void allocate(GLsizeiptr capacity);
+    void release();
+    void waitFor(GLintptr start, GLintptr end);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef STREAM_BUFFER_H */
@@ -0,0 +1,95 @@
+/**
+ * @file StrokeBatch.cpp
+ * @brief Implements the batched drawing of the strokes of many curves
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-17
+ */
+#include <stdexcept>
+
+#include "StrokeBatch.h"
+#include "ShaderRegistry.h"
+#include "StrokeStorage.h"
+
+#include "src/main/utils/Utils.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::utils;
+
+StrokeBatch::StrokeBatch() {
+
+    if(!Utils::isGlfwInitialized())
+        throw std::runtime_error("Please initialize GLFW.");
+
+    if(!Utils::isGlewInitialized())
+        throw std::runtime_error("Please initialize Glew.");
+
+    this->shader = ShaderRegistry::Instance()->get("stroke.vert",
+                                                   "overlay.frag");
+}
+
+/**
+ * Follows the list of curves to draw, which have to be prepared beforehand.
+ * The ranges of their tessellations are gathered again every frame, since a
+ * curve switches tessellation as the zoom changes.
+ */
+void StrokeBatch::update(const std::vector<Curve2D*>& curves) {
+
+    this->counts.clear();
+    this->offsets.clear();
+    this->baseVertices.clear();
+
+    for (auto& i : curves) {
+        const StrokeStorage::Range range = i->getStrokeRange();
+
+        this->counts.push_back(range.indexCount);
+        this->offsets.push_back(reinterpret_cast<const void*>(
+                range.firstIndex * sizeof(GLuint)));
+        this->baseVertices.push_back(range.firstVertex);
+    }
+
+    this->updateRuns(curves);
+}
+
+/**
+ * Draws the strokes of the curves of the list given to the last update.
+ */
+void StrokeBatch::render() {
+
+    if (this->runs.empty()) return;
+
+    this->shader->useProgram();
+    glBindVertexArray(StrokeStorage::Instance().getVertexArrayID());
+
+    for (auto& i : this->runs) {
+        this->shader->setMatrix4("model", i.model);
+        glMultiDrawElementsBaseVertex(GL_TRIANGLES, &this->counts[i.first],
+                GL_UNSIGNED_INT, &this->offsets[i.first], i.count,
+                &this->baseVertices[i.first]);
+    }
+
+    glBindVertexArray(0);
+}
+
+/**
+ * Groups consecutive curves with the same model matrix, so that they share a
+ * draw call without changing the drawing order.
+ */
+void StrokeBatch::updateRuns(const std::vector<Curve2D*>& curves) {
+
+    this->runs.clear();
+
+    for (int i = 0; i < static_cast<int>(curves.size()); i++) {
+        const Eigen::Matrix4d& model = curves[i]->getModelMatrix();
+
+        if (!this->runs.empty() && this->runs.back().model == model) {
+            this->runs.back().count++;
+        }
+        else {
+            this->runs.push_back({model, i, 1});
+        }
+    }
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,55 @@
+/**
+ * @file StrokeBatch.h
+ * @brief Describes the batched drawing of the strokes of many curves
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-04-17
+ */
+#ifndef STROKE_BATCH_H
+#define STROKE_BATCH_H
+
+#include <memory>
+#include <vector>
+#include <Eigen/Core>
+#include <GL/glew.h>
+
+#include "Curve2D.h"
+#include "Shader.h"
+
+namespace iphito::renderer {
+
+/**
+ * Draws the strokes of a list of curves, whose tessellations all live in the
+ * buffers of the StrokeStorage, with one glMultiDrawElementsBaseVertex per
+ * run of consecutive curves sharing their model matrix. The color and the
+ * width of the strokes are vertex attributes, so they do not split the runs.
+ * The curves are drawn in the order of the list.
+ */
+class StrokeBatch {
+
+public:
+    StrokeBatch();
+
+    void update(const std::vector<Curve2D*>& curves);
+    void render();
+
+private:
+    struct Run {
+        Eigen::Matrix4d model;
+        int first;
+        int count;
+    };
+
+    std::shared_ptr<Shader> shader;
+
+    std::vector<GLsizei> counts;
+    std::vector<const void*> offsets;
+    std::vector<GLint> baseVertices;
+    std::vector<Run> runs;
+
+    void updateRuns(const std::vector<Curve2D*>& curves);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef STROKE_BATCH_H */
@@ -0,0 +1,170 @@
+/**
+ * @file StrokeStorage.cpp
+ * @brief Implements the buffers shared by the strokes of all the curves
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-06-12
+ */
+#include <algorithm>
+#include <stdexcept>
+
+#include "StrokeStorage.h"
+
+#include "src/main/utils/Utils.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::utils;
+
+/**
+ * The storage lives as long as the context, like the programs of the shader
+ * registry.
+ */
+StrokeStorage& StrokeStorage::Instance() {
+
+    static StrokeStorage* storage = new StrokeStorage();
+
+    return *storage;
+}
+
+StrokeStorage::StrokeStorage() : vertexBufferID{0}, styleBufferID{0},
+    indexBufferID{0} {
+
+    if(!Utils::isGlfwInitialized())
+        throw std::runtime_error("Please initialize GLFW.");
+
+    if(!Utils::isGlewInitialized())
+        throw std::runtime_error("Please initialize Glew.");
+
+    glGenVertexArrays(1, &this->vertexArrayObjectID);
+    glGenBuffers(1, &this->vertexBufferID);
+    glGenBuffers(1, &this->styleBufferID);
+    glGenBuffers(1, &this->indexBufferID);
+    this->setVertexAttributes();
+}
+
+/**
+ * Allocates the ranges of a tessellation. An empty tessellation gets empty
+ * ranges, which draw nothing.
+ */
+StrokeStorage::Range StrokeStorage::allocate(GLsizei vertexCount,
+                                             GLsizei indexCount) {
+
+    if (vertexCount <= 0 || indexCount <= 0) return Range{0, 0, 0, 0};
+
+    Range range{0, vertexCount, 0, indexCount};
+    range.firstVertex = this->allocate(this->vertexRanges,
+            {{&this->vertexBufferID, StrokeStorage::vertexSize},
+             {&this->styleBufferID, StrokeStorage::styleSize}}, vertexCount);
+    range.firstIndex = this->allocate(this->indexRanges,
+            {{&this->indexBufferID, sizeof(GLuint)}}, indexCount);
+
+    return range;
+}
+
+void StrokeStorage::release(const Range& range) {
+
+    this->vertexRanges.release(range.firstVertex, range.vertexCount);
+    this->indexRanges.release(range.firstIndex, range.indexCount);
+}
+
+GLuint StrokeStorage::getVertexArrayID() {
+
+    return this->vertexArrayObjectID;
+}
+
+GLuint StrokeStorage::getVertexBufferID() {
+
+    return this->vertexBufferID;
+}
+
+GLuint StrokeStorage::getStyleBufferID() {
+
+    return this->styleBufferID;
+}
+
+GLuint StrokeStorage::getIndexBufferID() {
+
+    return this->indexBufferID;
+}
+
+/**
+ * Allocates a range of count elements in the buffers indexed by the
+ * allocator, growing them when no free range is large enough. Growing copies
+ * the content of every buffer into a new one at least twice as large, so that
+ * the ranges already handed out stay valid.
+ */
+std::ptrdiff_t StrokeStorage::allocate(RangeAllocator& ranges,
+                                       std::initializer_list<Buffer> buffers,
+                                       GLsizei count) {
+
+    std::ptrdiff_t first = ranges.allocate(count);
+    if (first != RangeAllocator::noOffset) return first;
+
+    const std::size_t capacity = ranges.getCapacity();
+    const std::size_t grown = std::max(2 * capacity, capacity + count);
+
+    for (auto& [bufferID, unit] : buffers) {
+        GLuint grownBufferID = 0;
+        glGenBuffers(1, &grownBufferID);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, grownBufferID);
+        glBufferData(GL_COPY_WRITE_BUFFER, grown * unit, NULL,
+                     GL_DYNAMIC_DRAW);
+
+        if (capacity > 0) {
+            glBindBuffer(GL_COPY_READ_BUFFER, *bufferID);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0,
+                                0, capacity * unit);
+        }
+
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glDeleteBuffers(1, bufferID);
+        *bufferID = grownBufferID;
+    }
+
+    ranges.grow(grown);
+
+    this->setVertexAttributes();
+
+    return ranges.allocate(count);
+}
+
+/**
+ * Points the vertex array at the current buffers: the centerline point of a
+ * vertex at location 0 and its offset at location 1, then its color, width,
+ * whether the width is in pixels and depth at locations 2 to 5.
+ */
+void StrokeStorage::setVertexAttributes() {
+
+    const GLsizei stride = StrokeStorage::vertexSize;
+    const GLsizei styleStride = StrokeStorage::styleSize;
+
+    glBindVertexArray(this->vertexArrayObjectID);
+    glBindBuffer(GL_ARRAY_BUFFER, this->vertexBufferID);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->indexBufferID);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, stride, NULL);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<const void*>(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, this->styleBufferID);
+
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, styleStride, NULL);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, styleStride,
+                          reinterpret_cast<const void*>(3 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, styleStride,
+                          reinterpret_cast<const void*>(4 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, styleStride,
+                          reinterpret_cast<const void*>(5 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(5);
+
+    glBindVertexArray(0);
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,90 @@
+/**
+ * @file StrokeStorage.h
+ * @brief Describes the buffers shared by the strokes of all the curves
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-06-12
+ */
+#ifndef STROKE_STORAGE_H
+#define STROKE_STORAGE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <GL/glew.h>
+
+#include "RangeAllocator.h"
+
+namespace iphito::renderer {
+
+/**
+ * One vertex buffer and one index buffer holding the tessellations of the
+ * strokes of all the curves, with the vertex array describing them. Every
+ * tessellation owns a range of both buffers, handed out by a RangeAllocator,
+ * and its indices start at 0 so that they are drawn with its first vertex as
+ * base vertex. The buffers are never bound to another vertex array, so any
+ * set of strokes can be drawn with a single multi-draw.
+ *
+ * The style of the stroke, i.e. its color, width and depth, is stored per
+ * vertex in a style buffer parallel to the vertex buffer, so that strokes of
+ * different styles share a draw call, and a style is changed without writing
+ * the geometry again.
+ *
+ * The buffers grow when no free range is large enough, and their identifiers
+ * change then. Has to be used from the thread owning the GL context, which
+ * the storage lives as long as.
+ */
+class StrokeStorage {
+
+public:
+    /* The ranges of a tessellation, in vertices and indices. */
+    struct Range {
+        std::ptrdiff_t firstVertex;
+        GLsizei vertexCount;
+        std::ptrdiff_t firstIndex;
+        GLsizei indexCount;
+    };
+
+    static StrokeStorage& Instance();
+
+    Range allocate(GLsizei vertexCount, GLsizei indexCount);
+    void release(const Range& range);
+    GLuint getVertexArrayID();
+    GLuint getVertexBufferID();
+    GLuint getStyleBufferID();
+    GLuint getIndexBufferID();
+
+    /* Centerline point and offset of a stroke vertex. */
+    static constexpr int floatsPerVertex = 4;
+
+    /* Color, width, whether the width is in pixels and depth, of a stroke
+     * vertex. */
+    static constexpr int floatsPerStyle = 6;
+
+    static constexpr GLsizeiptr vertexSize = floatsPerVertex * sizeof(GLfloat);
+    static constexpr GLsizeiptr styleSize = floatsPerStyle * sizeof(GLfloat);
+
+private:
+    StrokeStorage();
+    StrokeStorage(const StrokeStorage& s) = delete;
+    StrokeStorage& operator=(const StrokeStorage& s) = delete;
+
+    GLuint vertexArrayObjectID;
+    GLuint vertexBufferID;
+    GLuint styleBufferID;
+    GLuint indexBufferID;
+    RangeAllocator vertexRanges;
+    RangeAllocator indexRanges;
+
+    /* A buffer indexed by a RangeAllocator and the size of its elements. */
+    using Buffer = std::pair<GLuint*, GLsizeiptr>;
+
+    std::ptrdiff_t allocate(RangeAllocator& ranges,
+                            std::initializer_list<Buffer> buffers,
+                            GLsizei count);
+    void setVertexAttributes();
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef STROKE_STORAGE_H */
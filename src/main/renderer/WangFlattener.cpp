@@ -0,0 +1,107 @@
+/**
+ * @file WangFlattener.cpp
+ * @brief Implements a sampler flattening polynomial curves with Wang's formula
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-13
+ */
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+#include "WangFlattener.h"
+
+#include "src/main/utils/Logger.h"
+
+namespace iphito::renderer {
+
+using namespace iphito::math;
+using namespace iphito::utils;
+
+void WangFlattener::sample(Curve& curve, const Eigen::Matrix4d& transform,
+                           double tolerance, unsigned long long /* seed */,
+                           double a, double b,
+                           std::vector<double>& parameters,
+                           std::vector<Eigen::Vector2d>& points) {
+
+    const int segments = WangFlattener::wangSegments(
+            WangFlattener::screenControlPoints(curve, transform), tolerance,
+            b - a, WangFlattener::maximumSegments);
+    const std::size_t offset = parameters.size();
+
+    parameters.resize(offset + segments + 1);
+    points.resize(offset + segments + 1);
+
+    for (int i = 0; i < segments; i++)
+        parameters[offset + i] = a + (b - a) * i / segments;
+    parameters[offset + segments] = b;
+
+    curve.evaluateAt(std::span<const double>(parameters).subspan(offset),
+                     std::span<Eigen::Vector2d>(points).subspan(offset));
+}
+
+int WangFlattener::segmentCount(Curve& curve,
+                                const Eigen::Matrix4d& transform,
+                                double tolerance) {
+
+    return WangFlattener::wangSegments(
+            WangFlattener::screenControlPoints(curve, transform), tolerance,
+            1.0, WangFlattener::maximumSegments);
+}
+
+/**
+ * Wang's segment count for Bézier control points in screen space, over a
+ * parameter interval of the given length, rounded up and clamped to
+ * [1, maximum]. A clamped count no longer keeps the chords within the
+ * tolerance, e.g. for curves of high degree at deep zoom, which is logged
+ * once.
+ */
+int WangFlattener::wangSegments(
+        const std::vector<Eigen::Vector2d>& controlPoints, double tolerance,
+        double length, int maximum) {
+
+    const int degree = controlPoints.size() - 1;
+
+    if (degree < 2) return 1;
+
+    double difference = 0.0;
+    for (int i = 0; i + 2 <= degree; i++) {
+        difference = std::max(difference, (controlPoints[i+2] -
+                2.0 * controlPoints[i+1] + controlPoints[i]).norm());
+    }
+
+    double count = std::ceil(length * std::sqrt(degree * (degree - 1.0) *
+                                                difference /
+                                                (8.0 * tolerance)));
+
+    /* A degenerate transform, e.g. of an empty viewport, gives no bound. */
+    if (std::isnan(count)) count = 1.0;
+
+    if (count > maximum) {
+        std::call_once(WangFlattener::clampWarning, [] {
+            Logger::Instance()->warn("too many segments for the tolerance, "
+                                     "some curves are drawn coarser");
+        });
+    }
+
+    return static_cast<int>(std::clamp(count, 1.0,
+                                       static_cast<double>(maximum)));
+}
+
+/**
+ * The control points of the Bézier equivalent of the curve, mapped to screen
+ * space without the translation, which cancels out in the second
+ * differences.
+ */
+std::vector<Eigen::Vector2d> WangFlattener::screenControlPoints(
+        Curve& curve, const Eigen::Matrix4d& transform) {
+
+    const Eigen::Matrix2d linear = transform.topLeftCorner<2, 2>();
+    std::vector<Eigen::Vector2d> controlPoints = curve.getBezierPoints();
+
+    for (auto& i : controlPoints) i = linear * i;
+
+    return controlPoints;
+}
+
+} /* namespace iphito::renderer */
@@ -0,0 +1,61 @@
+/**
+ * @file WangFlattener.h
+ * @brief Describes a sampler flattening polynomial curves with Wang's formula
+ * @author Samuel Gauthier
+ * @version 0.1.0
+ * @date 2021-03-13
+ */
+#ifndef WANG_FLATTENER_H
+#define WANG_FLATTENER_H
+
+#include <mutex>
+#include <vector>
+#include <Eigen/Core>
+
+#include "Sampler.h"
+
+namespace iphito::renderer {
+
+/**
+ * Flattens a curve in a single pass using Wang's formula. For a Bézier curve
+ * of degree n with control points P_i mapped to screen space,
+ *
+ *     N = ceil(sqrt(n (n - 1) M / (8 tolerance))),
+ *     M = max |P_{i+2} - 2 P_{i+1} + P_i|,
+ *
+ * uniform segments are enough to keep every chord within the tolerance of the
+ * curve. Other curves are flattened through their Bézier equivalent. A
+ * sub-interval [a, b] gets its share (b - a) N of the segments, since the
+ * second differences of the restricted curve scale with (b - a)^2. All the
+ * points are then evaluated with a single batch call.
+ *
+ * The transform is assumed affine, which holds for the orthographic
+ * projections of the renderer. The count is capped, so the tolerance only
+ * holds as long as the cap is not hit, which a warning tells.
+ */
+class WangFlattener : public Sampler {
+
+public:
+    using Sampler::sample;
+    void sample(iphito::math::Curve& curve, const Eigen::Matrix4d& transform,
+                double tolerance, unsigned long long seed, double a, double b,
+                std::vector<double>& parameters,
+                std::vector<Eigen::Vector2d>& points) override;
+
+    int segmentCount(iphito::math::Curve& curve,
+                     const Eigen::Matrix4d& transform, double tolerance);
+
+    static int wangSegments(const std::vector<Eigen::Vector2d>& controlPoints,
+                            double tolerance, double length, int maximum);
+
+private:
+    static constexpr int maximumSegments = 4096;
+    inline static std::once_flag clampWarning;
+
+    static std::vector<Eigen::Vector2d> screenControlPoints(
+            iphito::math::Curve& curve, const Eigen::Matrix4d& transform);
+};
+
+} /* namespace iphito::renderer */
+
+#endif /* ifndef WANG_FLATTENER_H */
@@ -31,6 +31,8 @@ Window::Window(int x, int y, std::string title) :
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);    
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_SAMPLES, 4);
+    /* The layers order their curves with the depth test. */
+    glfwWindowHint(GLFW_DEPTH_BITS, 24);
 
     this->window.reset(glfwCreateWindow(this->x, this->y, this->title.c_str(),
                                         NULL, NULL));
@@ -64,6 +66,12 @@ Window::Window(int x, int y, std::string title) :
     this->setMouseCallbacks();
     glfwSetWindowSizeCallback(this->window.get(),
                               this->updateWindowSizeCallback);
+    glfwSetWindowRefreshCallback(this->window.get(),
+                                 this->windowRefreshCallback);
+
+    /* Swapping waits for the display, so the events arriving during a frame
+     * are handled together before the next one. */
+    glfwSwapInterval(1);
 
     Window::currentWindowWidth = this->x;
     Window::currentWindowHeight = this->y;
@@ -73,9 +81,15 @@ Window::Window(int x, int y, std::string title) :
     /* glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); */
     glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 
+    /* Antialiased discs output their coverage as alpha. */
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
     updateViewMatrix();
     updateProjectionMatrix();
 
+    this->cameraUniformBuffer.reset(new CameraUniformBuffer());
+
     initializeAxes();
     initializeGrid();
     updateGridAABB();
@@ -96,8 +110,12 @@ void Window::render() {
     /* Loop until the user closes the window */
     while (!glfwWindowShouldClose(this->window.get()))
     {
-        /* Render here */
-        glClear(GL_COLOR_BUFFER_BIT);
+        /* Handle every pending event at once, sleeping until one arrives
+         * when there is nothing to draw. */
+        if (this->frameScheduler.isFrameRequested())
+            glfwPollEvents();
+        else
+            glfwWaitEvents();
 
         if(Window::mouseScrolling || Window::windowResizing)
         {
@@ -106,18 +124,42 @@ void Window::render() {
             this->grid->updateProjectionMatrix(Window::projection);
             this->axes->updateProjectionMatrix(Window::projection);
             this->canvas->updateProjectionMatrix(Window::projection);
+            this->updateCanvasViewportSize();
             Window::mouseScrolling = false;
             Window::windowResizing = false;
+            Window::cursorMoving = true;
+            this->frameScheduler.requestFrame();
         }
-        if (Window::leftMouseButtonPressed) {
+        if (Window::cameraMoving) {
             this->updateViewMatrix();
             this->updateGridAABB();
             this->grid->updateViewMatrix(Window::view);
             this->axes->updateViewMatrix(Window::view);
             this->canvas->updateViewMatrix(Window::view);
-            /* Window::windowResizing = false; */
+            Window::cameraMoving = false;
+            Window::cursorMoving = true;
+            this->frameScheduler.requestFrame();
+        }
+        if (Window::cursorMoving) {
+            this->updateHoveredCurve();
+            Window::cursorMoving = false;
+        }
+        if (Window::windowDamaged) {
+            Window::windowDamaged = false;
+            this->frameScheduler.requestFrame();
         }
 
+        if (!this->frameScheduler.isFrameRequested()) continue;
+
+        /* Render here */
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        int width = 0;
+        int height = 0;
+        this->getFramebufferSize(width, height);
+        this->cameraUniformBuffer->update(Window::view, Window::projection,
+                                          Eigen::Vector2d(width, height));
+
         this->grid->render();
         this->axes->render();
         this->canvas->render();
@@ -125,18 +167,53 @@ void Window::render() {
         /* Swap front and back buffers */
         glfwSwapBuffers(this->window.get());
 
-        /* Poll for and process events */
-        /* glfwPollEvents(); */
-        glfwWaitEvents();
+        this->frameScheduler.frameRendered(glfwGetTime());
     }
 }
 
+/**
+ * In continuous mode, a frame is drawn on every iteration without waiting for
+ * the vertical synchronization, and the frame times are logged.
+ */
+void Window::setContinuousRendering(bool isContinuous) {
+
+    this->frameScheduler.setContinuous(isContinuous);
+    glfwSwapInterval(isContinuous ? 0 : 1);
+}
+
 void Window::setCanvas(std::unique_ptr<Canvas>& canvas) {
     this->canvas = std::move(canvas);
     // TODO: This is ugly doing it here but we cannot do it in the constructor
     // because the canvas pointer is not set yet
     this->canvas->updateViewMatrix(Window::view);
     this->canvas->updateProjectionMatrix(Window::projection);
+    this->updateCanvasViewportSize();
+    this->updateGridAABB();
+}
+
+/**
+ * Size of the framebuffer in pixels, which differs from the window size on
+ * high density displays.
+ */
+void Window::getFramebufferSize(int& width, int& height) {
+
+    glfwGetFramebufferSize(this->window.get(), &width, &height);
+}
+
+/**
+ * The tessellation tolerance is expressed in pixels of the framebuffer, which
+ * differ from the window size on high density displays.
+ */
+void Window::updateCanvasViewportSize() {
+
+    int width = 0;
+    int height = 0;
+    this->getFramebufferSize(width, height);
+
+    /* The framebuffer of a minimized window is empty. */
+    if (width <= 0 || height <= 0) return;
+
+    this->canvas->updateViewportSize(width, height);
 }
 
 void Window::setMouseCallbacks() {
@@ -181,7 +258,10 @@ void Window::cursorPositionCallback(GLFWwindow* window, double xPosition,
 
         Window::cameraPosition += cameraTranslation;
         Window::cameraTarget += cameraTranslation;
+        Window::cameraMoving = true;
     }
+
+    Window::cursorMoving = true;
 }
 
 void Window::updateMousePosition(GLFWwindow* window) {
@@ -224,7 +304,12 @@ void Window::updateWindowSizeCallback(GLFWwindow* window, int width,
 
     int newWidth = width;
     int newHeight = height;
-    glViewport(0, 0, newWidth, newHeight);
+
+    /* The viewport is measured in pixels of the framebuffer. */
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
 
     Window::currentWindowWidth = newWidth;
     Window::currentWindowHeight = newHeight;
@@ -232,6 +317,54 @@ void Window::updateWindowSizeCallback(GLFWwindow* window, int width,
     Window::windowResizing = true;
 }
 
+/**
+ * The content of the window was lost, e.g. when it was uncovered.
+ */
+void Window::windowRefreshCallback(GLFWwindow* window) {
+
+    Window::windowDamaged = true;
+}
+
+/**
+ * Maps a position in screen coordinates, as given to the cursor callbacks, to
+ * the world.
+ */
+Eigen::Vector2d Window::screenToWorld(GLFWwindow* window, double xPosition,
+                                      double yPosition) {
+
+    int windowWidth = 0;
+    int windowHeight = 0;
+    glfwGetWindowSize(window, &windowWidth, &windowHeight);
+
+    Eigen::Vector4d positionScreen(2.0 * xPosition / windowWidth - 1.0,
+                                   1.0 - 2.0 * yPosition / windowHeight,
+                                   0.0, 1.0);
+    Eigen::Vector4d positionWorld = Window::viewInverse *
+                                    Window::projectionInverse *
+                                    positionScreen;
+
+    return positionWorld.head<2>();
+}
+
+/**
+ * Highlights the curve under the cursor, asking for a frame when it changed.
+ */
+void Window::updateHoveredCurve() {
+
+    double xPosition = 0.0;
+    double yPosition = 0.0;
+    glfwGetCursorPos(this->window.get(), &xPosition, &yPosition);
+
+    Eigen::Vector2d position = Window::screenToWorld(this->window.get(),
+                                                     xPosition, yPosition);
+    double radius = (Window::screenToWorld(this->window.get(),
+                                           xPosition + Window::hoverRadius,
+                                           yPosition) - position).norm();
+
+    if (this->canvas->updateHover(position, radius))
+        this->frameScheduler.requestFrame();
+}
+
 void Window::initializeAxes() {
 
     Eigen::Vector3d white(1.0, 1.0, 1.0);
@@ -250,7 +383,7 @@ void Window::initializeGrid() {
 
     Eigen::Vector3d white(0.4, 0.4, 0.4);
 
-    this->grid.reset(new Grid(white));
+    this->grid.reset(new Grid(white, Grid::Mode::Procedural));
     this->grid->updateViewMatrix(Window::view);
     this->grid->updateProjectionMatrix(Window::projection);
 }
@@ -270,6 +403,9 @@ void Window::updateGridAABB() {
     max[1] = Window::cameraTarget[1] + hRatio;
 
     this->grid->setViewAABB(AABB(min, max));
+
+    if (this->canvas)
+        this->canvas->updateViewAABB(AABB(min, max));
 }
 
 void Window::updateViewMatrix() {
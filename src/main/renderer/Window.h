@@ -15,7 +15,9 @@
 
 #include "Arrow2D.h"
 #include "Axes2D.h"
+#include "CameraUniformBuffer.h"
 #include "Canvas.h"
+#include "FrameScheduler.h"
 #include "Grid.h"
 
 namespace iphito::renderer {
@@ -36,6 +38,8 @@ public:
 
     void render();
     void setCanvas(std::unique_ptr<Canvas>& canvas);
+    void setContinuousRendering(bool isContinuous);
+    void getFramebufferSize(int& width, int& height);
 
 private:
     void setMouseCallbacks();
@@ -48,11 +52,16 @@ private:
                                      double yOffset);
     static void updateWindowSizeCallback(GLFWwindow* window, int width,
                                          int height);
+    static void windowRefreshCallback(GLFWwindow* window);
+    static Eigen::Vector2d screenToWorld(GLFWwindow* window, double xPosition,
+                                         double yPosition);
+    void updateHoveredCurve();
     void updateViewMatrix();
     void updateProjectionMatrix();
     void initializeAxes();
     void initializeGrid();
     void updateGridAABB();
+    void updateCanvasViewportSize();
 
     int x;
     int y;
@@ -61,11 +70,16 @@ private:
     smart_GLFWwindow window;
     std::unique_ptr<Axes2D> axes;
     std::unique_ptr<Grid> grid;
+    std::unique_ptr<CameraUniformBuffer> cameraUniformBuffer;
+    FrameScheduler frameScheduler;
 
     inline static bool leftMouseButtonPressed = false;
     inline static bool rightMouseButtonPressed = false;
     inline static bool mouseScrolling = false;
     inline static bool windowResizing = false;
+    inline static bool cameraMoving = false;
+    inline static bool windowDamaged = false;
+    inline static bool cursorMoving = false;
     inline static Eigen::Vector2d mousePosition = Eigen::Vector2d::Zero();
 
     inline static Eigen::Matrix4d view = Eigen::Matrix4d::Zero();
@@ -84,6 +98,9 @@ private:
     inline static double initialWindowHeight = 1;
     inline static double zoomFactor = 1.0;
 
+    /* Distance in screen coordinates within which a curve is hovered. */
+    static constexpr double hoverRadius = 6.0;
+
 };
 
 } /* namespace iphito::renderer */
@@ -0,0 +1,133 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief Implements a fixed size pool of worker threads
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-03-20
+ */
+#include "ThreadPool.h"
+
+namespace iphito::utils {
+
+ThreadPool::ThreadPool(unsigned int workerCount) : job{nullptr},
+    generation{0}, stopping{false} {
+
+    for (unsigned int i = 0; i < workerCount; i++)
+        this->workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+
+    this->jobAvailable.notify_all();
+
+    for (auto& i : this->workers) i.join();
+}
+
+unsigned int ThreadPool::getWorkerCount() {
+
+    return this->workers.size();
+}
+
+/**
+ * One worker less than the hardware threads, the caller being the last one.
+ */
+unsigned int ThreadPool::defaultWorkerCount() {
+
+    unsigned int threads = std::thread::hardware_concurrency();
+
+    return threads > 1 ? threads - 1 : 0;
+}
+
+void ThreadPool::parallelFor(std::size_t count,
+                             const std::function<void(std::size_t)>& task) {
+
+    if (count == 0) return;
+
+    std::lock_guard<std::mutex> submissionLock(this->submission);
+
+    auto job = std::make_shared<Job>();
+    job->task = &task;
+    job->count = count;
+    job->next = 0;
+    job->completed = 0;
+    job->failed = false;
+
+    if (count > 1 && !this->workers.empty()) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->job = job;
+        this->generation++;
+        this->jobAvailable.notify_all();
+    }
+
+    this->run(*job);
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->jobDone.wait(lock, [&job]() {
+            return job->completed.load() == job->count;
+        });
+        this->job = nullptr;
+    }
+
+    if (job->exception) std::rethrow_exception(job->exception);
+}
+
+void ThreadPool::work() {
+
+    unsigned long long seen = 0;
+
+    while (true) {
+        std::shared_ptr<Job> job;
+
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->jobAvailable.wait(lock, [this, seen]() {
+                return this->stopping || this->generation != seen;
+            });
+
+            if (this->stopping) return;
+
+            seen = this->generation;
+            job = this->job;
+        }
+
+        if (job) this->run(*job);
+    }
+}
+
+/**
+ * Claims and runs iterations until none is left. The job outlives the call
+ * of parallelFor through the shared pointers of the workers, but the task
+ * itself is only touched for claimed iterations, which all complete before
+ * parallelFor returns.
+ */
+void ThreadPool::run(Job& job) {
+
+    std::size_t i = 0;
+
+    while ((i = job.next.fetch_add(1)) < job.count) {
+
+        if (!job.failed.load()) {
+            try {
+                (*job.task)(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!job.failed.exchange(true))
+                    job.exception = std::current_exception();
+            }
+        }
+
+        if (job.completed.fetch_add(1) + 1 == job.count) {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->jobDone.notify_all();
+        }
+    }
+}
+
+} /* namespace iphito::utils */
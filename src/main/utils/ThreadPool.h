@@ -0,0 +1,78 @@
+/**
+ * @file ThreadPool.h
+ * @brief Describes a fixed size pool of worker threads
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-03-20
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iphito::utils {
+
+/**
+ * A fixed set of worker threads sharing the iterations of parallelFor with
+ * the calling thread. Iterations are claimed one at a time, so uneven
+ * workloads such as curves of different complexity balance themselves.
+ */
+class ThreadPool {
+
+public:
+    /**
+     * @param workerCount the number of threads besides the caller. With zero
+     * workers parallelFor runs serially on the calling thread.
+     */
+    ThreadPool(unsigned int workerCount = ThreadPool::defaultWorkerCount());
+    ~ThreadPool();
+
+    unsigned int getWorkerCount();
+
+    /**
+     * Calls task(i) for every i in [0, count) and returns once all the calls
+     * returned. The first exception thrown by a task is rethrown here, after
+     * the remaining iterations have been skipped.
+     */
+    void parallelFor(std::size_t count,
+                     const std::function<void(std::size_t)>& task);
+
+    static unsigned int defaultWorkerCount();
+
+private:
+    ThreadPool(const ThreadPool& t) = delete;
+    ThreadPool& operator=(const ThreadPool& t) = delete;
+
+    struct Job {
+        const std::function<void(std::size_t)>* task;
+        std::size_t count;
+        std::atomic<std::size_t> next;
+        std::atomic<std::size_t> completed;
+        std::atomic<bool> failed;
+        std::exception_ptr exception;
+    };
+
+    void work();
+    void run(Job& job);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::mutex submission;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobDone;
+    std::shared_ptr<Job> job;
+    unsigned long long generation;
+    bool stopping;
+};
+
+} /* namespace iphito::utils */
+
+#endif /* ifndef THREAD_POOL_H */
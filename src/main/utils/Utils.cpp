@@ -10,6 +10,7 @@
 #include <cmath>
 #include <fstream>
 #include <limits>
+#include <sstream>
 #include <stdexcept>
 #include <vector>
 
@@ -28,16 +29,16 @@ const std::vector<unsigned long long> Utils::factorials = {
     5040,
     40320,
     362880,
-    13628800,
-    139916800,
-    1479001600,
-    16227020800,
-    187178291200,
-    11307674368000,
-    120922789888000,
-    1355687428096000,
-    16402373705728000,
-    1121645100408832000
+    3628800,
+    39916800,
+    479001600,
+    6227020800,
+    87178291200,
+    1307674368000,
+    20922789888000,
+    355687428096000,
+    6402373705728000,
+    121645100408832000
 };
 
 bool Utils::glfwInitialized = false;
@@ -56,6 +57,57 @@ const unsigned long long Utils::factorial(int n) {
     return Utils::factorials[n];
 }
 
+const double Utils::binomial(int n, int k) {
+    if(n < 0 || k < 0 || k > n) {
+        throw std::domain_error("Binomial coefficients are only defined for"
+                " 0 <= k <= n.");
+    }
+
+    // C(n, k) = prod_{i=1}^{k} (n - k + i) / i, every partial product being
+    // itself a binomial coefficient, so there is no intermediate overflow.
+    k = std::min(k, n - k);
+    double result = 1.0;
+
+    for (int i = 1; i <= k; i++) {
+        result = result * (n - k + i) / i;
+    }
+
+    if(!std::isfinite(result)) {
+        throw std::overflow_error("The binomial coefficient is too large for"
+                " a double.");
+    }
+
+    return std::round(result);
+}
+
+/**
+ * Counter-based hash: the splitmix64 finalizer applied to the key combined
+ * with the hashed counter. The result only depends on its arguments, so it can
+ * replace a shared random engine when reproducibility or thread safety
+ * matters.
+ */
+const unsigned long long Utils::hash(unsigned long long key,
+                                     unsigned long long counter) {
+
+    auto mix = [](unsigned long long x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    };
+
+    return mix(key ^ mix(counter));
+}
+
+/**
+ * Maps hash(key, counter) to a double uniformly distributed in [0, 1).
+ */
+const double Utils::uniform(unsigned long long key,
+                            unsigned long long counter) {
+
+    return (Utils::hash(key, counter) >> 11) * 0x1.0p-53;
+}
+
 const bool Utils::isGlfwInitialized() { return Utils::glfwInitialized; }
 
 const bool Utils::isGlewInitialized() { return Utils::glewInitialized; }
@@ -74,23 +126,15 @@ void Utils::setGlewInitialized() {
 
 const std::string Utils::readFile(std::string filePath) {
 
-    std::string content;
-    std::ifstream fileStream(filePath, std::ios::in);
-
-    if(fileStream.is_open()) {
-
-        std::string line = "";
-
-        while(getline(fileStream, line)) content += "\n" + line;
-
-        fileStream.close();
-    }
-    else {
+    std::ifstream fileStream(filePath, std::ios::in | std::ios::binary);
 
+    if(!fileStream.is_open())
         throw std::invalid_argument("Cannot open file: " + filePath);
-    }
 
-    return content;
+    std::stringstream content;
+    content << fileStream.rdbuf();
+
+    return content.str();
 }
 
 const std::string Utils::readInput() {
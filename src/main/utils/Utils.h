@@ -20,6 +20,11 @@ public:
     ~Utils() = delete;
 
     static const unsigned long long factorial(int n);
+    static const double binomial(int n, int k);
+    static const unsigned long long hash(unsigned long long key,
+                                         unsigned long long counter);
+    static const double uniform(unsigned long long key,
+                                unsigned long long counter);
     static const bool isGlfwInitialized();
     static const bool isGlewInitialized();
     static void setGlfwInitialized();
@@ -2,9 +2,13 @@
 
 layout(location=0) in vec4 inPosition;
 
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec2 viewport;
+};
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 void main(void) {
     gl_Position = projection * view * model * inPosition;
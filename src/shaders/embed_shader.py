@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+"""Wraps a GLSL source into a C++ header holding it as a raw string literal.
+
+Usage: embed_shader.py <input> <output>
+
+The variable is named after the file, e.g. basic.vert gives basic_vert.
+"""
+import os
+import sys
+
+DELIMITER = 'iphito_glsl'
+
+source_path, header_path = sys.argv[1], sys.argv[2]
+name = os.path.basename(source_path).replace('.', '_')
+
+with open(source_path, encoding='utf-8') as f:
+    source = f.read()
+
+if ')' + DELIMITER + '"' in source:
+    sys.exit(source_path + ' contains the raw string delimiter')
+
+with open(header_path, 'w', encoding='utf-8') as f:
+    f.write('/* Generated from ' + os.path.basename(source_path) +
+            ', do not edit. */\n')
+    f.write('#pragma once\n\n')
+    f.write('namespace iphito::shaders {\n\n')
+    f.write('inline constexpr const char ' + name + '[] = R"' + DELIMITER +
+            '(' + source + ')' + DELIMITER + '";\n\n')
+    f.write('} /* namespace iphito::shaders */\n')
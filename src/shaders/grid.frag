@@ -0,0 +1,23 @@
+#version 410
+
+in vec2 world;
+flat in float spacing;
+
+uniform vec3 color;
+
+out vec4 outColor;
+
+/* Coverage of the lines one pixel wide every given number of units. */
+float lines(float interval) {
+    vec2 coordinates = world / interval;
+    vec2 distance = abs(fract(coordinates - 0.5) - 0.5) / fwidth(coordinates);
+    return 1.0 - min(min(distance.x, distance.y), 1.0);
+}
+
+void main(void) {
+    float coverage = max(0.5 * lines(spacing), lines(10.0 * spacing));
+
+    if (coverage == 0.0) discard;
+
+    outColor = vec4(color, coverage);
+}
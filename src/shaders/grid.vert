@@ -0,0 +1,25 @@
+#version 410
+
+/* Corner of the viewport in normalized device coordinates. */
+layout(location=0) in vec2 inPosition;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec2 viewport;
+};
+
+out vec2 world;
+flat out float spacing;
+
+void main(void) {
+    mat4 transform = projection * view;
+    world = (inverse(transform) * vec4(inPosition, 0, 1)).xy;
+
+    /* A tenth of the largest side of the view, rounded down to a power of
+     * ten. */
+    vec2 extent = 2.0 / vec2(length(transform[0].xy), length(transform[1].xy));
+    spacing = pow(10.0, floor(log(max(extent.x, extent.y)) / log(10.0) - 1.0));
+
+    gl_Position = vec4(inPosition, 0, 1);
+}
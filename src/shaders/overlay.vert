@@ -0,0 +1,43 @@
+#version 410
+
+/*
+ * Unit mesh vertex: x is measured along the direction in lengths, y across it
+ * in widths and z along it in widths.
+ */
+layout(location=0) in vec3 inPosition;
+
+layout(location=1) in vec2 instancePosition;
+layout(location=2) in vec2 instanceDirection;
+layout(location=3) in vec2 instanceScale;
+layout(location=4) in vec3 instanceColor;
+layout(location=5) in float instanceThickness;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec2 viewport;
+};
+
+uniform mat4 model;
+
+/* Depth of the curve decorated, in normalized device coordinates. */
+uniform float depth;
+
+out vec3 color;
+out vec2 local;
+out float thickness;
+
+void main(void) {
+    vec2 along = normalize(instanceDirection);
+    vec2 across = vec2(-along.y, along.x);
+
+    vec2 position = instancePosition +
+        (inPosition.x * instanceScale.x + inPosition.z * instanceScale.y) *
+        along + inPosition.y * instanceScale.y * across;
+
+    gl_Position = projection * view * model * vec4(position, 0, 1);
+    gl_Position.z = depth * gl_Position.w;
+    color = instanceColor;
+    local = inPosition.xy;
+    thickness = instanceThickness;
+}
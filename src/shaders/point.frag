@@ -0,0 +1,20 @@
+#version 410
+
+in vec3 color;
+in vec2 local;
+in float thickness;
+
+out vec4 outColor;
+
+void main(void) {
+    /* Signed distance to the ring covering the disc from its rim inwards,
+     * in radii, antialiased over one pixel. A whole disc is a ring as thick
+     * as its radius. */
+    float halfThickness = 0.5 * thickness;
+    float distance = abs(length(local) - 1.0 + halfThickness) - halfThickness;
+    float coverage = clamp(0.5 - distance / fwidth(distance), 0.0, 1.0);
+
+    if (coverage == 0.0) discard;
+
+    outColor = vec4(color, coverage);
+}
@@ -0,0 +1,47 @@
+#version 410
+
+/*
+ * Centerline point of the stroke and its offset to one side: the unit normal
+ * of the curve scaled by the miter factor of the joint.
+ */
+layout(location=0) in vec2 inPosition;
+layout(location=1) in vec2 inOffset;
+
+/* Style of the stroke, the same for all the vertices of a curve. */
+layout(location=2) in vec3 inColor;
+layout(location=3) in float inWidth;
+layout(location=4) in float inIsWidthInPixels;
+layout(location=5) in float inDepth;
+
+layout(std140) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec2 viewport;
+};
+
+uniform mat4 model;
+
+out vec3 color;
+
+void main(void) {
+    mat4 transform = projection * view * model;
+    color = inColor;
+
+    if (inIsWidthInPixels == 0.0) {
+        gl_Position = transform * vec4(inPosition + 0.5 * inWidth * inOffset,
+                                       0, 1);
+        gl_Position.z = inDepth * gl_Position.w;
+        return;
+    }
+
+    /* Normals map with the inverse transpose of the linear part, here from
+     * the space of the curve to pixels. */
+    mat2 toPixels = mat2(0.5 * viewport.x, 0, 0, 0.5 * viewport.y) *
+                    mat2(transform);
+    vec2 normal = normalize(transpose(inverse(toPixels)) * inOffset);
+    vec2 offset = 0.5 * inWidth * length(inOffset) * normal;
+
+    vec4 center = transform * vec4(inPosition, 0, 1);
+    gl_Position = center + vec4(2.0 * offset / viewport * center.w, 0, 0);
+    gl_Position.z = inDepth * gl_Position.w;
+}
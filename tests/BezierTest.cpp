@@ -7,7 +7,10 @@
  */
 #include <Eigen/Core>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <memory>
+#include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #include "src/main/math/Bezier.h"
@@ -170,4 +173,244 @@ TEST_CASE("Bezier Berstein coefficients can be retrieved", "[Bezier]") {
   REQUIRE(pointsAndBernstein[0].second == 1.0);
   REQUIRE(pointsAndBernstein[1].second == 2.0);
   REQUIRE(pointsAndBernstein[2].second == 1.0);
+
+  std::vector<Eigen::Vector2d> q(2001, p0);
+  Bezier b2(q);
+  REQUIRE_THROWS_AS(b2.getPointsAndBernstein(), std::overflow_error);
+}
+
+TEST_CASE("A Bezier curve can be evaluated in batches", "[Bezier]") {
+
+  const std::vector<Eigen::Vector2d> q = {p0, p1, p2, Eigen::Vector2d(3, 2),
+                                          Eigen::Vector2d(1, -1)};
+  Bezier b1(q);
+  Curve& c1 = b1;
+
+  std::vector<double> t;
+  for (int i = 0; i <= 10; i++) {
+    t.push_back(i / 10.0);
+  }
+  std::vector<Eigen::Vector2d> points(t.size());
+
+  c1.evaluateAt(t, points);
+
+  for (std::size_t i = 0; i < t.size(); i++) {
+    Eigen::Vector2d expected = b1.evaluateAt(t[i]);
+    REQUIRE(Utils::nearlyEqual(points[i][0], expected[0]) == true);
+    REQUIRE(Utils::nearlyEqual(points[i][1], expected[1]) == true);
+  }
+}
+
+TEST_CASE("Bezier curves match de Casteljau's algorithm", "[Bezier]") {
+
+  std::vector<Eigen::Vector2d> q;
+  for (int i = 0; i <= 8; i++) {
+    q.push_back(Eigen::Vector2d(i, (i % 3) - 1.0));
+  }
+  Bezier b1(q);
+
+  for (double t = 0.0; t <= 1.0; t += 0.05) {
+    std::vector<Eigen::Vector2d> r = q;
+    for (int k = r.size() - 1; k > 0; k--) {
+      for (int i = 0; i < k; i++) {
+        r[i] = (1 - t) * r[i] + t * r[i + 1];
+      }
+    }
+
+    REQUIRE((b1.evaluateAt(t) - r[0]).norm() < 1e-12);
+  }
+}
+
+TEST_CASE("Bezier control points can be changed", "[Bezier]") {
+
+  Bezier b1(p);
+
+  std::vector<Eigen::Vector2d> q = {p2, p1, p0};
+  b1.setPoints(q);
+
+  REQUIRE(b1.getPoints() == q);
+  REQUIRE((b1.evaluateAt(0.0) - p2).norm() < 1e-12);
+  REQUIRE((b1.evaluateAt(1.0) - p0).norm() < 1e-12);
+  REQUIRE((b1.evaluateAt(0.5) - Eigen::Vector2d(0.25, 0.5)).norm() < 1e-12);
+}
+
+TEST_CASE("High degree Bezier curves can be evaluated", "[Bezier]") {
+
+  for (int degree : {60, 1000, 2000}) {
+
+    std::vector<Eigen::Vector2d> q;
+    for (int i = 0; i <= degree; i++) {
+      q.push_back(Eigen::Vector2d(std::cos(i * 0.1), std::sin(i * 0.37)));
+    }
+    Bezier b1(q);
+
+    std::vector<double> t;
+    for (int i = 0; i <= 10; i++) {
+      t.push_back(i / 10.0);
+    }
+    std::vector<Eigen::Vector2d> points(t.size());
+    b1.evaluateAt(t, points);
+
+    for (std::size_t j = 0; j < t.size(); j++) {
+      std::vector<long double> rx(q.size());
+      std::vector<long double> ry(q.size());
+      for (std::size_t i = 0; i < q.size(); i++) {
+        rx[i] = q[i][0];
+        ry[i] = q[i][1];
+      }
+      for (int k = q.size() - 1; k > 0; k--) {
+        for (int i = 0; i < k; i++) {
+          rx[i] = (1 - t[j]) * rx[i] + t[j] * rx[i + 1];
+          ry[i] = (1 - t[j]) * ry[i] + t[j] * ry[i + 1];
+        }
+      }
+
+      Eigen::Vector2d expected(rx[0], ry[0]);
+      REQUIRE((b1.evaluateAt(t[j]) - expected).norm() < 1e-10);
+      REQUIRE((points[j] - expected).norm() < 1e-10);
+    }
+  }
+}
+
+TEST_CASE("Bezier curves have analytic derivatives", "[Bezier]") {
+  Bezier b1(p);
+
+  REQUIRE(b1.derivativeAt(0.0).isApprox(Eigen::Vector2d(2, 2)));
+  REQUIRE(b1.derivativeAt(1.0).isApprox(Eigen::Vector2d(4, -2)));
+  REQUIRE(b1.derivativeAt(0.5).isApprox(Eigen::Vector2d(3, 0)));
+  REQUIRE(b1.secondDerivativeAt(0.3).isApprox(Eigen::Vector2d(2, -4)));
+
+  REQUIRE(std::abs(b1.curvatureAt(0.5) + 12.0 / 27.0) < 1e-12);
+  REQUIRE(b1.tangentAt(0.5).isApprox(Eigen::Vector2d(1, 0)));
+  REQUIRE(b1.normalAt(0.5).isApprox(Eigen::Vector2d(0, 1)));
+
+  Bezier line({p0, p2});
+  REQUIRE(line.derivativeAt(0.7).isApprox(p2 - p0));
+  REQUIRE(line.secondDerivativeAt(0.7) == Eigen::Vector2d::Zero());
+  REQUIRE(line.curvatureAt(0.7) == 0.0);
+}
+
+TEST_CASE("Bezier derivatives can be evaluated in batches", "[Bezier]") {
+  std::vector<Eigen::Vector2d> points;
+  for (int i = 0; i <= 8; i++) {
+    points.emplace_back(i, std::sin(i));
+  }
+  Bezier b1(points);
+  Curve& c1 = b1;
+
+  std::vector<double> t = {0.0, 0.1, 0.25, 0.4, 0.5, 0.6, 0.75, 0.9, 1.0};
+  std::vector<Eigen::Vector2d> d1(t.size());
+  std::vector<Eigen::Vector2d> d2(t.size());
+  std::vector<double> curvatures(t.size());
+
+  c1.derivativeAt(t, d1);
+  c1.secondDerivativeAt(t, d2);
+  c1.curvatureAt(t, curvatures);
+
+  const double h = 1e-5;
+  for (std::size_t i = 0; i < t.size(); i++) {
+    REQUIRE((d1[i] - b1.derivativeAt(t[i])).norm() < 1e-12);
+    REQUIRE((d2[i] - b1.secondDerivativeAt(t[i])).norm() < 1e-12);
+    REQUIRE(std::abs(curvatures[i] - b1.curvatureAt(t[i])) < 1e-12);
+
+    Eigen::Vector2d difference =
+        (b1.evaluateAt(t[i] + h) - b1.evaluateAt(t[i] - h)) / (2 * h);
+    REQUIRE((d1[i] - difference).norm() < 1e-6);
+  }
+}
+
+TEST_CASE("High degree Bezier curves have analytic derivatives", "[Bezier]") {
+  std::vector<Eigen::Vector2d> points;
+  for (int i = 0; i <= 1000; i++) {
+    points.emplace_back(i / 10.0, std::sin(i / 100.0));
+  }
+  Bezier b1(points);
+
+  const double h = 1e-6;
+  for (double t : {0.1, 0.5, 0.9}) {
+    Eigen::Vector2d difference =
+        (b1.evaluateAt(t + h) - b1.evaluateAt(t - h)) / (2 * h);
+    REQUIRE((b1.derivativeAt(t) - difference).norm() < 1e-4);
+  }
+}
+
+TEST_CASE("Bezier curves can be subdivided", "[Bezier]") {
+  std::vector<Eigen::Vector2d> points = {p0, p1, p2, Eigen::Vector2d(3, 2)};
+  Bezier b1(points);
+
+  for (double s : {0.25, 0.5, 0.8}) {
+    auto [left, right] = Bezier::subdivide(points, s);
+    Bezier l(left);
+    Bezier r(right);
+
+    REQUIRE(left.front() == points.front());
+    REQUIRE(right.back() == points.back());
+    REQUIRE(left.back().isApprox(b1.evaluateAt(s)));
+    REQUIRE(right.front().isApprox(b1.evaluateAt(s)));
+
+    for (double t : {0.0, 0.3, 0.7, 1.0}) {
+      REQUIRE((l.evaluateAt(t) - b1.evaluateAt(s * t)).norm() < 1e-12);
+      REQUIRE((r.evaluateAt(t) - b1.evaluateAt(s + (1 - s) * t)).norm() <
+              1e-12);
+    }
+  }
+}
+
+TEST_CASE("the bounds of Bezier curves are exact", "[Bezier]") {
+
+  auto [min, max] = Bezier::bounds(p);
+
+  REQUIRE(min.isApprox(Eigen::Vector2d(-1, 0)));
+  REQUIRE(max.isApprox(Eigen::Vector2d(2, 0.5)));
+
+  std::vector<Eigen::Vector2d> points = {p0, Eigen::Vector2d(3, 4),
+                                         Eigen::Vector2d(-2, -3), p2,
+                                         Eigen::Vector2d(1, 2)};
+  Bezier b1(points);
+  std::tie(min, max) = Bezier::bounds(points);
+
+  Eigen::Vector2d sampledMin = b1.evaluateAt(0.0);
+  Eigen::Vector2d sampledMax = sampledMin;
+
+  for (int i = 1; i <= 10000; i++) {
+    Eigen::Vector2d e = b1.evaluateAt(i / 10000.0);
+    sampledMin = sampledMin.cwiseMin(e);
+    sampledMax = sampledMax.cwiseMax(e);
+  }
+
+  REQUIRE((min.array() <= sampledMin.array() + 1e-12).all());
+  REQUIRE((max.array() >= sampledMax.array() - 1e-12).all());
+  REQUIRE((min - sampledMin).norm() < 1e-6);
+  REQUIRE((max - sampledMax).norm() < 1e-6);
+
+  std::vector<Eigen::Vector2d> line = {p0, p2};
+  std::tie(min, max) = Bezier::bounds(line);
+  REQUIRE(min == Eigen::Vector2d(-1, 0));
+  REQUIRE(max == Eigen::Vector2d(2, 0));
+
+  REQUIRE_THROWS_AS(Bezier::bounds(std::vector<Eigen::Vector2d>()),
+                    std::length_error);
+}
+
+TEST_CASE("the closest point of a Bezier curve is found by Newton's method",
+          "[Bezier]") {
+
+  Bezier b1(p);
+  const Eigen::Vector2d point(0.8, 1.0);
+
+  double closest = 0.0;
+  for (int i = 0; i <= 100000; i++) {
+    double t = i / 100000.0;
+    if ((b1.evaluateAt(t) - point).norm() <
+        (b1.evaluateAt(closest) - point).norm())
+      closest = t;
+  }
+
+  double t = b1.closestParameterTo(point, 0.4);
+  REQUIRE(std::abs(t - closest) < 1e-4);
+  REQUIRE(std::abs((b1.evaluateAt(t) - point).dot(b1.derivativeAt(t))) <
+          1e-12);
+
+  REQUIRE(b1.closestParameterTo(Eigen::Vector2d(-2, -1), 0.2) == 0.0);
+  REQUIRE(b1.closestParameterTo(Eigen::Vector2d(3, -1), 0.8) == 1.0);
 }
@@ -0,0 +1,71 @@
+/**
+ * @file BoundingVolumeHierarchyTest.cpp
+ * @brief BoundingVolumeHierarchy tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-05-15
+ */
+#include "src/main/renderer/BoundingVolumeHierarchy.h"
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <vector>
+
+using namespace iphito::renderer;
+
+TEST_CASE("the boxes intersecting a region are found in increasing order",
+          "[BoundingVolumeHierarchy]") {
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> position(-100.0, 100.0);
+  std::uniform_real_distribution<double> size(0.0, 5.0);
+
+  std::vector<AABB> boxes;
+  for (int i = 0; i < 1000; i++) {
+    Eigen::Vector2d min(position(generator), position(generator));
+    Eigen::Vector2d max = min + Eigen::Vector2d(size(generator),
+                                                size(generator));
+    boxes.push_back(AABB(min, max));
+  }
+  boxes.push_back(AABB::empty());
+
+  BoundingVolumeHierarchy hierarchy;
+  hierarchy.build(boxes);
+
+  for (int i = 0; i < 50; i++) {
+    Eigen::Vector2d min(position(generator), position(generator));
+    Eigen::Vector2d max = min + Eigen::Vector2d(10.0 * size(generator),
+                                                10.0 * size(generator));
+    AABB region(min, max);
+
+    std::vector<int> expected;
+    for (std::size_t j = 0; j < boxes.size(); j++) {
+      if (boxes[j].intersects(region)) expected.push_back(j);
+    }
+
+    std::vector<int> found;
+    hierarchy.query(region, found);
+
+    REQUIRE(found == expected);
+  }
+
+  std::vector<int> all;
+  hierarchy.query(AABB::unbounded(), all);
+  REQUIRE(all.size() == 1000);
+}
+
+TEST_CASE("the hierarchy bounds all of its boxes",
+          "[BoundingVolumeHierarchy]") {
+
+  BoundingVolumeHierarchy hierarchy;
+  std::vector<int> found;
+
+  hierarchy.query(AABB::unbounded(), found);
+  REQUIRE(found.empty());
+  REQUIRE(hierarchy.getAABB().intersects(AABB::unbounded()) == false);
+
+  hierarchy.build({AABB(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 1)),
+                   AABB(Eigen::Vector2d(-2, 3), Eigen::Vector2d(-1, 4))});
+
+  REQUIRE(hierarchy.getAABB().getMin() == Eigen::Vector2d(-2, 0));
+  REQUIRE(hierarchy.getAABB().getMax() == Eigen::Vector2d(1, 4));
+}
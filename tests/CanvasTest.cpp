@@ -6,13 +6,72 @@
  * @date 2018-10-01
  */
 #include "src/main/renderer/Canvas.h"
+#include "src/main/renderer/Bezier2D.h"
+#include "src/main/math/Bezier.h"
+#include "tests/GLContext.h"
+#include <Eigen/Core>
 #include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
 
+using namespace iphito::math;
 using namespace iphito::renderer;
 
+static std::unique_ptr<Curve2D> makeCurve(double height) {
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, height),
+                                         Eigen::Vector2d(0.5, height + 1),
+                                         Eigen::Vector2d(1, height)};
+
+  return std::unique_ptr<Curve2D>(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+}
+
 TEST_CASE("canvas size", "[Canvas]") {
   Canvas c = Canvas(3, 4);
 
   REQUIRE(c.getWidth() == 3);
   REQUIRE(c.getHeight() == 4);
 }
+
+TEST_CASE("the curve under the cursor is highlighted", "[Canvas]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  std::unique_ptr<Curve2D> lower = makeCurve(0.0);
+  std::unique_ptr<Curve2D> upper = makeCurve(2.0);
+  Curve2D* lowerCurve = lower.get();
+  Curve2D* upperCurve = upper.get();
+
+  std::shared_ptr<Layer> root(new Layer());
+  REQUIRE(root->addCurve(lower) == true);
+  REQUIRE(root->addCurve(upper) == true);
+
+  Canvas canvas(512, 512);
+  canvas.setRootLayer(root);
+  canvas.render();
+
+  const Eigen::Vector2d onLower(0.5, 0.5);
+  const Eigen::Vector2d onUpper(0.5, 2.5);
+
+  REQUIRE(canvas.updateHover(onLower, 0.05) == true);
+  REQUIRE(lowerCurve->getHighlighted() == true);
+  REQUIRE(canvas.updateHover(onLower + Eigen::Vector2d(0.01, 0), 0.05) ==
+          false);
+
+  REQUIRE(canvas.updateHover(onUpper, 0.05) == true);
+  REQUIRE(lowerCurve->getHighlighted() == false);
+  REQUIRE(upperCurve->getHighlighted() == true);
+
+  REQUIRE(canvas.updateHover(Eigen::Vector2d(5, 5), 0.05) == true);
+  REQUIRE(upperCurve->getHighlighted() == false);
+
+  SECTION("a new root layer clears the hovered curve", "[Canvas]") {
+
+    REQUIRE(canvas.updateHover(onLower, 0.05) == true);
+    canvas.setRootLayer(std::shared_ptr<Layer>(new Layer()));
+    REQUIRE(lowerCurve->getHighlighted() == false);
+    REQUIRE(canvas.updateHover(onLower, 0.05) == false);
+  }
+}
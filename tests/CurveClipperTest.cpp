@@ -0,0 +1,78 @@
+/**
+ * @file CurveClipperTest.cpp
+ * @brief CurveClipper tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-03-27
+ */
+#include <Eigen/Core>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "src/main/math/Bezier.h"
+#include "src/main/renderer/AABB.h"
+#include "src/main/renderer/CurveClipper.h"
+
+using namespace iphito::math;
+using namespace iphito::renderer;
+
+const std::vector<Eigen::Vector2d> points = {
+    Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2), Eigen::Vector2d(3, -2),
+    Eigen::Vector2d(4, 0)};
+
+TEST_CASE("intervals cover the whole parameter range", "[CurveClipper]") {
+
+  AABB region(Eigen::Vector2d(1.9, -0.5), Eigen::Vector2d(2.1, 0.5));
+  auto intervals = CurveClipper::clip(points, region);
+
+  REQUIRE(intervals.size() == 3);
+  REQUIRE(intervals.front().a == 0.0);
+  REQUIRE(intervals.back().b == 1.0);
+
+  for (std::size_t i = 1; i < intervals.size(); i++) {
+    REQUIRE(intervals[i].a == intervals[i - 1].b);
+    REQUIRE(intervals[i].visible != intervals[i - 1].visible);
+  }
+
+  REQUIRE(intervals[1].visible == true);
+  REQUIRE(intervals[1].a <= 0.5);
+  REQUIRE(intervals[1].b >= 0.5);
+}
+
+TEST_CASE("hidden intervals do not intersect the region", "[CurveClipper]") {
+
+  Bezier b(points);
+  AABB region(Eigen::Vector2d(0.5, 0.0), Eigen::Vector2d(1.0, 1.0));
+  auto intervals = CurveClipper::clip(points, region);
+
+  for (auto& i : intervals) {
+    if (i.visible) continue;
+    for (int k = 0; k <= 100; k++) {
+      double t = i.a + (i.b - i.a) * k / 100.0;
+      REQUIRE(region.contains(b.evaluateAt(t)) == false);
+    }
+  }
+}
+
+TEST_CASE("trivial regions are not subdivided", "[CurveClipper]") {
+
+  auto inside = CurveClipper::clip(points, AABB::unbounded());
+  REQUIRE(inside.size() == 1);
+  REQUIRE(inside[0].visible == true);
+
+  AABB far(Eigen::Vector2d(10, 10), Eigen::Vector2d(11, 11));
+  auto outside = CurveClipper::clip(points, far);
+  REQUIRE(outside.size() == 1);
+  REQUIRE(outside[0].visible == false);
+}
+
+TEST_CASE("the number of intervals is bounded", "[CurveClipper]") {
+
+  AABB tiny(Eigen::Vector2d(2, 0), Eigen::Vector2d(2 + 1e-12, 1e-12));
+  auto intervals = CurveClipper::clip(points, tiny);
+
+  REQUIRE(intervals.size() <= 3);
+  for (auto& i : intervals)
+    if (i.visible)
+      REQUIRE(i.b - i.a >= 1.0 / (1 << CurveClipper::maximumDepth));
+}
@@ -0,0 +1,75 @@
+/**
+ * @file FrameSchedulerTest.cpp
+ * @brief FrameScheduler tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-05-08
+ */
+#include "src/main/renderer/FrameScheduler.h"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+using namespace iphito::renderer;
+
+TEST_CASE("on demand, frames are only drawn when requested",
+          "[FrameScheduler]") {
+
+  FrameScheduler scheduler;
+
+  REQUIRE(scheduler.isFrameRequested() == true);
+  scheduler.frameRendered(0.0);
+  REQUIRE(scheduler.isFrameRequested() == false);
+
+  scheduler.requestFrame();
+  scheduler.requestFrame();
+  REQUIRE(scheduler.isFrameRequested() == true);
+  scheduler.frameRendered(1.0);
+  REQUIRE(scheduler.isFrameRequested() == false);
+  REQUIRE(scheduler.getFrameCount() == 0);
+}
+
+TEST_CASE("in continuous mode, every frame is drawn and timed",
+          "[FrameScheduler]") {
+
+  FrameScheduler scheduler(true, 10.0);
+
+  scheduler.frameRendered(1.0);
+  REQUIRE(scheduler.isFrameRequested() == true);
+  REQUIRE(scheduler.getFrameCount() == 0);
+
+  scheduler.frameRendered(1.25);
+  scheduler.frameRendered(1.75);
+  scheduler.frameRendered(2.5);
+
+  REQUIRE(scheduler.isFrameRequested() == true);
+  REQUIRE(scheduler.getFrameCount() == 3);
+  REQUIRE(scheduler.getMeanFrameTime() == 0.5);
+  REQUIRE(scheduler.getMinimumFrameTime() == 0.25);
+  REQUIRE(scheduler.getMaximumFrameTime() == 0.75);
+
+  scheduler.setContinuous(false);
+  REQUIRE(scheduler.isFrameRequested() == true);
+  scheduler.frameRendered(3.0);
+  REQUIRE(scheduler.isFrameRequested() == false);
+}
+
+TEST_CASE("the statistics start over after each report", "[FrameScheduler]") {
+
+  FrameScheduler scheduler(true, 1.0);
+
+  scheduler.frameRendered(0.0);
+  scheduler.frameRendered(0.5);
+  REQUIRE(scheduler.getFrameCount() == 1);
+
+  scheduler.frameRendered(1.0);
+  REQUIRE(scheduler.getFrameCount() == 0);
+
+  scheduler.frameRendered(1.25);
+  REQUIRE(scheduler.getFrameCount() == 1);
+  REQUIRE(scheduler.getMaximumFrameTime() == 0.25);
+}
+
+TEST_CASE("the report interval has to be positive", "[FrameScheduler]") {
+
+  REQUIRE_THROWS_AS(FrameScheduler(true, 0.0), std::domain_error);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file GLContext.h
+ * @brief OpenGL context shared by the tests which draw
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-06-12
+ */
+#ifndef TESTS_GL_CONTEXT_H
+#define TESTS_GL_CONTEXT_H
+
+#include "src/main/utils/Utils.h"
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+/* Makes the context of a hidden window current for the rest of the tests,
+ * returning whether there is one. All the test files share the context, since
+ * the shaders of the registry belong to it. */
+inline bool makeContextCurrent() {
+
+  static bool isCurrent = false;
+  if (isCurrent) return true;
+
+  if (!glfwInit()) return false;
+
+  if (glfwGetCurrentContext() == NULL) {
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GLFW_TRUE);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "iphito tests", NULL, NULL);
+    if (!window) return false;
+
+    glfwMakeContextCurrent(window);
+  }
+
+  if (glewInit() != GLEW_OK) return false;
+
+  iphito::utils::Utils::setGlfwInitialized();
+  iphito::utils::Utils::setGlewInitialized();
+  isCurrent = true;
+  return true;
+}
+
+#endif /* ifndef TESTS_GL_CONTEXT_H */
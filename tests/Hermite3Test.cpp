@@ -6,6 +6,9 @@
  * @date 2018-10-02
  */
 #include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 #include "src/main/math/Hermite3.h"
 #include <catch2/catch_test_macros.hpp>
@@ -95,3 +98,73 @@ TEST_CASE("Cubic Hermite curves can be evaluated", "[Hermite3]") {
   Eigen::Vector2d expected(-0.25, 0.5);
   REQUIRE(h1.evaluateAt(0.5) == expected);
 }
+
+TEST_CASE("Cubic Hermite curves can be evaluated in batches", "[Hermite3]") {
+  Hermite3 h1(p1, t1, p2, t2);
+  Curve& c1 = h1;
+
+  std::vector<double> t = {-1.0, 0.0, 0.1, 0.25, 0.5, 0.6, 0.75, 1.0, 2.0};
+  std::vector<Eigen::Vector2d> points(t.size());
+
+  c1.evaluateAt(t, points);
+
+  for (std::size_t i = 0; i < t.size(); i++) {
+    REQUIRE((points[i] - h1.evaluateAt(t[i])).norm() < 1e-12);
+  }
+}
+
+TEST_CASE("the whole description of cubic Hermite curves can be changed",
+          "[Hermite3]") {
+  Hermite3 h1(p1, t1, p2, t2);
+  Hermite3 h2(p2, t2, p1, t1);
+
+  h1.setCurveDescription(p2, t2, p1, t1);
+
+  REQUIRE(h1.getCurveMatrix() == h2.getCurveMatrix());
+  REQUIRE(h1.getStartControlPoint() == p2);
+  REQUIRE(h1.getStartTangentVector() == t2);
+  REQUIRE(h1.getEndControlPoint() == p1);
+  REQUIRE(h1.getEndTangentVector() == t1);
+}
+
+TEST_CASE("Cubic Hermite curves have analytic derivatives", "[Hermite3]") {
+  Hermite3 h1(p1, t1, p2, t2);
+  Curve& c1 = h1;
+
+  REQUIRE(h1.derivativeAt(0.0).isApprox(t1));
+  REQUIRE(h1.derivativeAt(1.0).isApprox(t2));
+
+  std::vector<double> t = {0.0, 0.1, 0.25, 0.5, 0.6, 0.75, 1.0};
+  std::vector<Eigen::Vector2d> d1(t.size());
+  std::vector<Eigen::Vector2d> d2(t.size());
+
+  c1.derivativeAt(t, d1);
+  c1.secondDerivativeAt(t, d2);
+
+  const double h = 1e-5;
+  for (std::size_t i = 0; i < t.size(); i++) {
+    double a = std::max(t[i] - h, 0.0);
+    double b = std::min(t[i] + h, 1.0);
+    Eigen::Vector2d difference =
+        (h1.evaluateAt(b) - h1.evaluateAt(a)) / (b - a);
+    REQUIRE((d1[i] - h1.derivativeAt(t[i])).norm() < 1e-12);
+    REQUIRE((d2[i] - h1.secondDerivativeAt(t[i])).norm() < 1e-12);
+    REQUIRE((d1[i] - difference).norm() < 1e-4);
+  }
+
+  Eigen::Vector2d d = h1.derivativeAt(0.5);
+  Eigen::Vector2d dd = h1.secondDerivativeAt(0.5);
+  double curvature = (d[0] * dd[1] - d[1] * dd[0]) / std::pow(d.norm(), 3);
+  REQUIRE(std::abs(h1.curvatureAt(0.5) - curvature) < 1e-12);
+}
+
+TEST_CASE("Cubic Hermite curves have a Bezier equivalent", "[Hermite3]") {
+  Hermite3 h1(p1, t1, p2, t2);
+
+  std::vector<Eigen::Vector2d> points = h1.getBezierPoints();
+  REQUIRE(points.size() == 4);
+  REQUIRE(points[0].isApprox(p1));
+  REQUIRE(points[1].isApprox(p1 + t1 / 3.0));
+  REQUIRE(points[2].isApprox(p2 - t2 / 3.0));
+  REQUIRE(points[3].isApprox(p2));
+}
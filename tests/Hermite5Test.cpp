@@ -6,7 +6,9 @@
  * @date 2018-10-11
  */
 #include <Eigen/Core>
+#include <vector>
 
+#include "src/main/math/Bezier.h"
 #include "src/main/math/Hermite5.h"
 #include <catch2/catch_test_macros.hpp>
 
@@ -119,3 +121,64 @@ TEST_CASE("Quintic Hermite curves can be evaluated", "[Hermite5]") {
   Eigen::Vector2d expected(-0.3125, 0.5);
   REQUIRE(h1.evaluateAt(0.5) == expected);
 }
+
+TEST_CASE("Quintic Hermite curves can be evaluated in batches", "[Hermite5]") {
+  Hermite5 h1(p1, v1, a1, p2, v2, a2);
+  Curve& c1 = h1;
+
+  std::vector<double> t = {-1.0, 0.0, 0.1, 0.25, 0.5, 0.6, 0.75, 1.0, 2.0};
+  std::vector<Eigen::Vector2d> points(t.size());
+
+  c1.evaluateAt(t, points);
+
+  for (std::size_t i = 0; i < t.size(); i++) {
+    REQUIRE((points[i] - h1.evaluateAt(t[i])).norm() < 1e-12);
+  }
+}
+
+TEST_CASE("the whole description of quintic Hermite curves can be changed",
+          "[Hermite5]") {
+  Hermite5 h1(p1, v1, a1, p2, v2, a2);
+  Hermite5 h2(p2, v2, a2, p1, v1, a1);
+
+  h1.setCurveDescription(p2, v2, a2, p1, v1, a1);
+
+  REQUIRE(h1.getCurveMatrix() == h2.getCurveMatrix());
+  REQUIRE(h1.getStartControlPoint() == p2);
+  REQUIRE(h1.getStartVelocityVector() == v2);
+  REQUIRE(h1.getStartAccelerationVector() == a2);
+  REQUIRE(h1.getEndControlPoint() == p1);
+  REQUIRE(h1.getEndVelocityVector() == v1);
+  REQUIRE(h1.getEndAccelerationVector() == a1);
+}
+
+TEST_CASE("Quintic Hermite curves have analytic derivatives", "[Hermite5]") {
+  Hermite5 h1(p1, v1, a1, p2, v2, a2);
+  Curve& c1 = h1;
+
+  REQUIRE(h1.derivativeAt(0.0).isApprox(v1));
+  REQUIRE(h1.derivativeAt(1.0).isApprox(v2));
+  REQUIRE(h1.secondDerivativeAt(0.0).isApprox(a1));
+  REQUIRE(h1.secondDerivativeAt(1.0).isApprox(a2));
+
+  std::vector<double> t = {0.0, 0.1, 0.25, 0.5, 0.6, 0.75, 1.0};
+  std::vector<Eigen::Vector2d> d1(t.size());
+  std::vector<Eigen::Vector2d> d2(t.size());
+
+  c1.derivativeAt(t, d1);
+  c1.secondDerivativeAt(t, d2);
+
+  for (std::size_t i = 0; i < t.size(); i++) {
+    REQUIRE((d1[i] - h1.derivativeAt(t[i])).norm() < 1e-12);
+    REQUIRE((d2[i] - h1.secondDerivativeAt(t[i])).norm() < 1e-12);
+  }
+}
+
+TEST_CASE("Quintic Hermite curves have a Bezier equivalent", "[Hermite5]") {
+  Hermite5 h1(p1, v1, a1, p2, v2, a2);
+  Bezier b1(h1.getBezierPoints());
+
+  for (double t : {0.0, 0.1, 0.25, 0.5, 0.6, 0.75, 1.0}) {
+    REQUIRE((b1.evaluateAt(t) - h1.evaluateAt(t)).norm() < 1e-12);
+  }
+}
@@ -6,12 +6,47 @@
  * @date 2018-09-28
  */
 #include "src/main/renderer/Layer.h"
+#include "src/main/renderer/Bezier2D.h"
+#include "src/main/renderer/StrokeStorage.h"
+#include "src/main/renderer/WangFlattener.h"
+#include "src/main/math/Bezier.h"
+#include "tests/GLContext.h"
+#include <Eigen/Core>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <vector>
 
+using namespace iphito::math;
 using namespace iphito::renderer;
 
+/* Counts the intervals sampled, i.e. the work of the tessellations. */
+class CountingSampler : public WangFlattener {
+
+public:
+  int count = 0;
+
+  using Sampler::sample;
+  void sample(Curve& curve, const Eigen::Matrix4d& transform,
+              double tolerance, unsigned long long seed, double a, double b,
+              std::vector<double>& parameters,
+              std::vector<Eigen::Vector2d>& points) override {
+    this->count++;
+    WangFlattener::sample(curve, transform, tolerance, seed, a, b, parameters,
+                          points);
+  }
+};
+
+/* A frame of the canvas: tessellating the curves, then drawing them. */
+static void renderFrame(Layer& layer) {
+
+  std::vector<Curve2D*> curves;
+  layer.collectCurvesToTessellate(curves);
+  for (auto& i : curves) i->tessellate();
+  layer.render();
+}
+
 TEST_CASE("layers have an unique ID", "[Layer]") {
 
   Layer l1;
@@ -63,3 +98,511 @@ TEST_CASE("layers can be constructed with other layers as their children",
     REQUIRE(l1->containsLayer(ids[i]) == true);
   }
 }
+
+TEST_CASE("nested layers are found and removed from any ancestor",
+          "[Layer]") {
+
+  std::unique_ptr<Layer> root(new Layer());
+  std::unique_ptr<Layer> child(new Layer());
+  std::unique_ptr<Layer> grandChild(new Layer());
+  std::unique_ptr<Layer> sibling(new Layer());
+
+  unsigned long long rootID = root->getID();
+  unsigned long long childID = child->getID();
+  unsigned long long grandChildID = grandChild->getID();
+  unsigned long long siblingID = sibling->getID();
+
+  Layer* childLayer = child.get();
+  Layer* siblingLayer = sibling.get();
+
+  REQUIRE(child->addLayer(grandChild) == true);
+  REQUIRE(root->addLayer(child) == true);
+  REQUIRE(root->addLayer(sibling) == true);
+
+  REQUIRE(root->containsLayer(childID) == true);
+  REQUIRE(root->containsLayer(grandChildID) == true);
+  REQUIRE(root->containsLayer(siblingID) == true);
+  REQUIRE(root->containsLayer(rootID) == false);
+  REQUIRE(childLayer->containsLayer(grandChildID) == true);
+  REQUIRE(childLayer->containsLayer(siblingID) == false);
+  REQUIRE(siblingLayer->containsLayer(grandChildID) == false);
+
+  SECTION("a layer cannot be removed from a layer not containing it",
+          "[Layer]") {
+
+    REQUIRE(siblingLayer->removeLayer(grandChildID) == false);
+    REQUIRE(root->containsLayer(grandChildID) == true);
+  }
+
+  SECTION("removing a layer removes its descendants", "[Layer]") {
+
+    REQUIRE(root->removeLayer(childID) == true);
+    REQUIRE(root->containsLayer(childID) == false);
+    REQUIRE(root->containsLayer(grandChildID) == false);
+    REQUIRE(root->containsLayer(siblingID) == true);
+    REQUIRE(root->removeLayer(childID) == false);
+  }
+
+  SECTION("a layer is removed from its parent", "[Layer]") {
+
+    REQUIRE(root->removeLayer(grandChildID) == true);
+    REQUIRE(childLayer->containsLayer(grandChildID) == false);
+    REQUIRE(root->containsLayer(childID) == true);
+  }
+}
+
+TEST_CASE("the curves of nested layers follow the zoom", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> curve(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  Curve2D* childCurve = curve.get();
+
+  std::unique_ptr<Layer> child(new Layer());
+  unsigned long long childID = child->getID();
+  REQUIRE(child->addCurve(curve) == true);
+
+  Eigen::Matrix4d projection = Eigen::Matrix4d::Identity();
+  std::unique_ptr<Layer> root(new Layer());
+  root->updateViewportSize(512, 512);
+  root->updateProjectionMatrix(projection);
+
+  SECTION("a grafted layer is given the camera of the tree", "[Layer]") {
+
+    REQUIRE(root->addLayer(child) == true);
+    renderFrame(*root);
+    REQUIRE(childCurve->getLevel() == 8);
+  }
+
+  SECTION("zooming changes the level of the curves of the children",
+          "[Layer]") {
+
+    REQUIRE(root->addLayer(child) == true);
+
+    projection(0, 0) = 8.0;
+    projection(1, 1) = 8.0;
+    root->updateProjectionMatrix(projection);
+    renderFrame(*root);
+    REQUIRE(childCurve->getLevel() == 11);
+
+    Eigen::Matrix4d view = Eigen::Matrix4d::Identity();
+    view(0, 0) = 0.5;
+    view(1, 1) = 0.5;
+    root->updateViewMatrix(view);
+    renderFrame(*root);
+    REQUIRE(childCurve->getLevel() == 10);
+  }
+
+  SECTION("moving a curve of a child moves the box of the tree", "[Layer]") {
+
+    REQUIRE(root->addLayer(child) == true);
+    AABB before = root->getAABB();
+
+    Eigen::Matrix4d model = Eigen::Matrix4d::Identity();
+    model(0, 3) = 10.0;
+    childCurve->updateModelMatrix(model);
+
+    AABB after = root->getAABB();
+    REQUIRE(after.getMin().isApprox(before.getMin() + Eigen::Vector2d(10, 0)));
+    REQUIRE(after.getMax().isApprox(before.getMax() + Eigen::Vector2d(10, 0)));
+  }
+
+  SECTION("removing a child empties the box of the tree", "[Layer]") {
+
+    REQUIRE(root->addLayer(child) == true);
+    REQUIRE(root->getAABB().intersects(AABB::unbounded()) == true);
+
+    REQUIRE(root->removeLayer(childID) == true);
+    REQUIRE(root->getAABB().intersects(AABB::unbounded()) == false);
+  }
+}
+
+TEST_CASE("only the visible curves are given the camera", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> near = {Eigen::Vector2d(0, 0),
+                                       Eigen::Vector2d(0.5, 1),
+                                       Eigen::Vector2d(1, 0)};
+  std::vector<Eigen::Vector2d> far = {Eigen::Vector2d(100, 0),
+                                      Eigen::Vector2d(100.5, 1),
+                                      Eigen::Vector2d(101, 0)};
+  std::unique_ptr<Curve2D> c1(new Bezier2D(
+      std::make_shared<Bezier>(near), 1.0, black, black, black));
+  std::unique_ptr<Curve2D> c2(new Bezier2D(
+      std::make_shared<Bezier>(far), 1.0, black, black, black));
+  Curve2D* visibleCurve = c1.get();
+  Curve2D* culledCurve = c2.get();
+
+  Layer layer;
+  REQUIRE(layer.addCurve(c1) == true);
+  REQUIRE(layer.addCurve(c2) == true);
+  layer.updateViewportSize(512, 512);
+  renderFrame(layer);
+  REQUIRE(culledCurve->getLevel() == 8);
+
+  Eigen::Matrix4d projection = Eigen::Matrix4d::Identity();
+  projection(0, 0) = 8.0;
+  projection(1, 1) = 8.0;
+  layer.updateProjectionMatrix(projection);
+  layer.updateViewAABB(AABB(Eigen::Vector2d(0.0, 0.0),
+                            Eigen::Vector2d(0.25, 0.25)));
+  renderFrame(layer);
+
+  REQUIRE(visibleCurve->getLevel() == 11);
+  REQUIRE(culledCurve->getLevel() == 8);
+}
+
+TEST_CASE("panning tessellates a curve only once", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> curve(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  Curve2D* pannedCurve = curve.get();
+  auto sampler = std::make_shared<CountingSampler>();
+  curve->setSampler(sampler);
+
+  Layer layer;
+  REQUIRE(layer.addCurve(curve) == true);
+  layer.updateViewportSize(512, 512);
+
+  layer.updateViewAABB(AABB(Eigen::Vector2d(0.0, 0.0),
+                            Eigen::Vector2d(0.1, 0.1)));
+  renderFrame(layer);
+  REQUIRE(pannedCurve->hasToBeTessellated() == false);
+
+  int before = sampler->count;
+  layer.updateViewAABB(AABB(Eigen::Vector2d(0.8, 0.0),
+                            Eigen::Vector2d(0.9, 0.1)));
+
+  std::vector<Curve2D*> curves;
+  layer.collectCurvesToTessellate(curves);
+  REQUIRE(curves.size() == 1);
+  curves[0]->tessellate();
+  int tessellated = sampler->count;
+  REQUIRE(tessellated > before);
+
+  layer.render();
+  REQUIRE(sampler->count == tessellated);
+  REQUIRE(pannedCurve->hasToBeTessellated() == false);
+
+  renderFrame(layer);
+  REQUIRE(sampler->count == tessellated);
+}
+
+TEST_CASE("the strokes of the curves share the stroke storage", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> c1(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  std::unique_ptr<Curve2D> c2(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  Curve2D* first = c1.get();
+  Curve2D* second = c2.get();
+  unsigned long long firstID = first->getID();
+
+  Layer layer;
+  REQUIRE(layer.addCurve(c1) == true);
+  REQUIRE(layer.addCurve(c2) == true);
+  layer.updateViewportSize(512, 512);
+  renderFrame(layer);
+
+  StrokeStorage::Range r1 = first->getStrokeRange();
+  StrokeStorage::Range r2 = second->getStrokeRange();
+  REQUIRE(r1.indexCount > 0);
+  REQUIRE(r2.indexCount > 0);
+  REQUIRE((r1.firstVertex + r1.vertexCount <= r2.firstVertex ||
+           r2.firstVertex + r2.vertexCount <= r1.firstVertex));
+  REQUIRE((r1.firstIndex + r1.indexCount <= r2.firstIndex ||
+           r2.firstIndex + r2.indexCount <= r1.firstIndex));
+
+  /* The ranges of a removed curve are free again, so the first free ranges
+   * large enough start at the latest where they did. */
+  REQUIRE(layer.removeCurve(firstID) == true);
+  StrokeStorage::Range r3 = StrokeStorage::Instance().allocate(
+      r1.vertexCount, r1.indexCount);
+  REQUIRE(r3.firstVertex <= r1.firstVertex);
+  REQUIRE(r3.firstIndex <= r1.firstIndex);
+  StrokeStorage::Instance().release(r3);
+}
+
+TEST_CASE("restyling a curve keeps its tessellation", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> curve(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  Curve2D* styledCurve = curve.get();
+  auto sampler = std::make_shared<CountingSampler>();
+  curve->setSampler(sampler);
+
+  Layer layer;
+  REQUIRE(layer.addCurve(curve) == true);
+  layer.updateViewportSize(512, 512);
+  renderFrame(layer);
+
+  int tessellated = sampler->count;
+  StrokeStorage::Range before = styledCurve->getStrokeRange();
+
+  styledCurve->setHighlighted(true);
+  styledCurve->setCurveWidth(3.0);
+  styledCurve->setWidthInPixels(true);
+  REQUIRE(styledCurve->hasToBeTessellated() == false);
+
+  renderFrame(layer);
+  StrokeStorage::Range after = styledCurve->getStrokeRange();
+  REQUIRE(sampler->count == tessellated);
+  REQUIRE(after.firstVertex == before.firstVertex);
+  REQUIRE(after.firstIndex == before.firstIndex);
+}
+
+TEST_CASE("the curves of a layer are ordered by their depth", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> c1(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  std::unique_ptr<Curve2D> c2(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  Curve2D* first = c1.get();
+  Curve2D* second = c2.get();
+
+  Layer layer;
+  REQUIRE(layer.addCurve(c1) == true);
+  layer.updateViewportSize(512, 512);
+  renderFrame(layer);
+  double depth = first->getDepth();
+
+  /* The curve added last is drawn first, under the others, which keep their
+   * depth. */
+  REQUIRE(layer.addCurve(c2) == true);
+  renderFrame(layer);
+  REQUIRE(first->getDepth() == depth);
+  REQUIRE(second->getDepth() > first->getDepth());
+}
+
+TEST_CASE("moving a clipped curve tessellates it again", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> curve(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+  Curve2D* movedCurve = curve.get();
+
+  Layer layer;
+  REQUIRE(layer.addCurve(curve) == true);
+  layer.updateViewportSize(512, 512);
+
+  Eigen::Matrix4d model = Eigen::Matrix4d::Identity();
+  model(0, 3) = 0.3;
+
+  SECTION("a clipped curve is tessellated again", "[Layer]") {
+
+    layer.updateViewAABB(AABB(Eigen::Vector2d(0.0, 0.0),
+                              Eigen::Vector2d(0.1, 0.1)));
+    renderFrame(layer);
+    REQUIRE(movedCurve->hasToBeTessellated() == false);
+
+    movedCurve->updateModelMatrix(model);
+    REQUIRE(movedCurve->hasToBeTessellated() == true);
+  }
+
+  SECTION("a whole curve keeps its tessellation", "[Layer]") {
+
+    renderFrame(layer);
+    REQUIRE(movedCurve->hasToBeTessellated() == false);
+
+    movedCurve->updateModelMatrix(model);
+    REQUIRE(movedCurve->hasToBeTessellated() == false);
+  }
+}
+
+TEST_CASE("curves just outside the view are culled with the same margin",
+          "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::unique_ptr<Layer> root(new Layer());
+  root->updateViewportSize(512, 512);
+  root->updateProjectionMatrix(Eigen::Matrix4d::Identity());
+
+  SECTION("the stroke of a width in pixels reaches into the view",
+          "[Layer]") {
+
+    std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(1.05, -0.5),
+                                           Eigen::Vector2d(1.05, 0.0),
+                                           Eigen::Vector2d(1.05, 0.5)};
+    std::unique_ptr<Curve2D> curve(new Bezier2D(
+        std::make_shared<Bezier>(points), 20.0, black, black, black));
+    curve->setWidthInPixels(true);
+    REQUIRE(root->addCurve(curve) == true);
+  }
+
+  SECTION("a child layer is culled as its curves are", "[Layer]") {
+
+    std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(1.025, -0.5),
+                                           Eigen::Vector2d(1.025, 0.0),
+                                           Eigen::Vector2d(1.025, 0.5)};
+    std::unique_ptr<Curve2D> curve(new Bezier2D(
+        std::make_shared<Bezier>(points), 0.001, black, black, black));
+    std::unique_ptr<Layer> child(new Layer());
+    REQUIRE(child->addCurve(curve) == true);
+    REQUIRE(root->addLayer(child) == true);
+  }
+
+  root->updateViewAABB(AABB(Eigen::Vector2d(-1.0, -1.0),
+                            Eigen::Vector2d(1.0, 1.0)));
+
+  std::vector<Curve2D*> curves;
+  root->collectCurvesToTessellate(curves);
+  REQUIRE(curves.size() == 1);
+}
+
+TEST_CASE("a curve is picked as it is drawn after zooming out", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<Eigen::Vector2d> points = {Eigen::Vector2d(0, 0),
+                                         Eigen::Vector2d(0.5, 1),
+                                         Eigen::Vector2d(1, 0)};
+  std::unique_ptr<Curve2D> curve(new Bezier2D(
+      std::make_shared<Bezier>(points), 1.0, black, black, black));
+
+  Layer layer;
+  REQUIRE(layer.addCurve(curve) == true);
+  layer.updateViewportSize(512, 512);
+
+  Eigen::Matrix4d projection = Eigen::Matrix4d::Identity();
+  layer.updateProjectionMatrix(projection);
+  renderFrame(layer);
+
+  /* Zooming in clips the tessellation of the new level to the view. */
+  projection(0, 0) = 8.0;
+  projection(1, 1) = 8.0;
+  layer.updateProjectionMatrix(projection);
+  layer.updateViewAABB(AABB(Eigen::Vector2d(0.0, 0.0),
+                            Eigen::Vector2d(0.1, 0.1)));
+  renderFrame(layer);
+
+  /* Zooming back out draws the whole cached tessellation again. */
+  layer.updateProjectionMatrix(Eigen::Matrix4d::Identity());
+  layer.updateViewAABB(AABB::unbounded());
+  renderFrame(layer);
+
+  CurvePick pick;
+  REQUIRE(layer.pick(Eigen::Vector2d(0.75, 0.375), 0.01, pick) == true);
+  REQUIRE(std::abs(pick.parameter - 0.75) < 1e-6);
+  REQUIRE(pick.distance < 1e-6);
+}
+
+TEST_CASE("picking finds the closest curve of nested layers", "[Layer]") {
+
+  if (!makeContextCurrent()) SKIP("No OpenGL context is available.");
+
+  const Eigen::Vector3d black(0, 0, 0);
+  std::vector<std::shared_ptr<Bezier>> beziers = {
+      std::make_shared<Bezier>(std::vector<Eigen::Vector2d>{
+          Eigen::Vector2d(0, 0), Eigen::Vector2d(0.5, 1),
+          Eigen::Vector2d(1, 0)}),
+      std::make_shared<Bezier>(std::vector<Eigen::Vector2d>{
+          Eigen::Vector2d(0, 1), Eigen::Vector2d(1, -1),
+          Eigen::Vector2d(2, 2), Eigen::Vector2d(3, 0)}),
+      std::make_shared<Bezier>(std::vector<Eigen::Vector2d>{
+          Eigen::Vector2d(-1, 0.5), Eigen::Vector2d(0, -0.5),
+          Eigen::Vector2d(0.5, 0.5)}),
+      std::make_shared<Bezier>(std::vector<Eigen::Vector2d>{
+          Eigen::Vector2d(0, 0), Eigen::Vector2d(0.2, 0.8),
+          Eigen::Vector2d(0.8, 0.2), Eigen::Vector2d(1, 1)})};
+
+  /* The curves of the child are stretched, so that the radius is brought to
+   * their space through their model matrix. */
+  std::vector<Eigen::Matrix4d> models(beziers.size(),
+                                      Eigen::Matrix4d::Identity());
+  models[2](0, 0) = 2.0;
+  models[2](1, 1) = 0.5;
+  models[3](0, 0) = 3.0;
+  models[3](0, 1) = 1.0;
+  models[3](1, 3) = -1.0;
+
+  std::unique_ptr<Layer> root(new Layer());
+  std::unique_ptr<Layer> child(new Layer());
+  std::vector<Curve2D*> curves;
+
+  for (int i = 0; i < beziers.size(); i++) {
+    std::unique_ptr<Curve2D> curve(new Bezier2D(beziers[i], 1.0, black,
+                                                black, black));
+    curves.push_back(curve.get());
+    curve->updateModelMatrix(models[i]);
+    REQUIRE((i < 2 ? root : child)->addCurve(curve) == true);
+  }
+
+  REQUIRE(root->addLayer(child) == true);
+  root->updateViewportSize(512, 512);
+  renderFrame(*root);
+
+  /* The distance to every curve, from a dense sampling of the curve. */
+  auto distanceTo = [&](int curve, const Eigen::Vector2d& point) {
+    double distance = std::numeric_limits<double>::infinity();
+    for (int i = 0; i <= 20000; i++) {
+      Eigen::Vector2d p = beziers[curve]->evaluateAt(i / 20000.0);
+      Eigen::Vector4d q = models[curve] * Eigen::Vector4d(p[0], p[1], 0, 1);
+      distance = std::min(distance, (q.head<2>() - point).norm());
+    }
+    return distance;
+  };
+
+  const double radius = 0.2;
+
+  for (double x = -1.5; x <= 3.5; x += 0.25) {
+    for (double y = -1.5; y <= 2.5; y += 0.25) {
+
+      const Eigen::Vector2d point(x, y);
+      double closest = std::numeric_limits<double>::infinity();
+      for (int i = 0; i < curves.size(); i++) {
+        closest = std::min(closest, distanceTo(i, point));
+      }
+
+      CurvePick pick;
+      bool isPicked = root->pick(point, radius, pick);
+
+      if (closest < radius - 1e-3) {
+        REQUIRE(isPicked == true);
+        REQUIRE(std::abs(pick.distance - closest) < 1e-4);
+        REQUIRE((pick.point - point).norm() == pick.distance);
+      }
+      else if (closest > radius + 1e-3) {
+        REQUIRE(isPicked == false);
+      }
+    }
+  }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file LevelOfDetailTest.cpp
+ * @brief LevelOfDetail tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-03-27
+ */
+#include "src/main/renderer/LevelOfDetail.h"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+using namespace iphito::renderer;
+
+TEST_CASE("levels are the integer part of log2 of the scale",
+          "[LevelOfDetail]") {
+
+  LevelOfDetail lod;
+
+  REQUIRE(lod.update(1.0) == true);
+  REQUIRE(lod.getLevel() == 0);
+  REQUIRE(lod.getLevelScale() == 2.0);
+
+  REQUIRE(lod.update(1.9) == false);
+  REQUIRE(lod.update(300.0) == true);
+  REQUIRE(lod.getLevel() == 8);
+  REQUIRE(lod.getLevelScale() == 512.0);
+
+  REQUIRE(lod.update(0.0) == false);
+  REQUIRE(lod.update(-1.0) == false);
+  REQUIRE(lod.getLevel() == 8);
+
+  REQUIRE_THROWS_AS(LevelOfDetail(0), std::domain_error);
+}
+
+TEST_CASE("levels only go down past the hysteresis", "[LevelOfDetail]") {
+
+  LevelOfDetail lod(4, 0.25);
+  lod.update(16.0);
+  REQUIRE(lod.getLevel() == 4);
+
+  REQUIRE(lod.update(15.0) == false);
+  REQUIRE(lod.getLevel() == 4);
+  REQUIRE(lod.update(14.0) == false);
+  REQUIRE(lod.getLevel() == 4);
+
+  REQUIRE(lod.update(12.0) == true);
+  REQUIRE(lod.getLevel() == 3);
+
+  REQUIRE(lod.update(16.0) == true);
+  REQUIRE(lod.getLevel() == 4);
+}
+
+TEST_CASE("cached levels are evicted least recently used first",
+          "[LevelOfDetail]") {
+
+  LevelOfDetail lod(2);
+
+  lod.update(1.0);
+  REQUIRE(lod.find() == -1);
+  int first = lod.insert();
+  REQUIRE(lod.find() == first);
+
+  lod.update(4.0);
+  REQUIRE(lod.find() == -1);
+  int second = lod.insert();
+  REQUIRE(second != first);
+
+  lod.update(1.0);
+  REQUIRE(lod.find() == first);
+
+  lod.update(64.0);
+  REQUIRE(lod.insert() == second);
+
+  lod.update(4.0);
+  REQUIRE(lod.find() == -1);
+
+  lod.clear();
+  lod.update(64.0);
+  REQUIRE(lod.find() == -1);
+}
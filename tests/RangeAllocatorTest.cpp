@@ -0,0 +1,70 @@
+/**
+ * @file RangeAllocatorTest.cpp
+ * @brief RangeAllocator tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-05-29
+ */
+#include "src/main/renderer/RangeAllocator.h"
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+using namespace iphito::renderer;
+
+TEST_CASE("ranges are allocated one after the other", "[RangeAllocator]") {
+
+  RangeAllocator allocator(10);
+
+  REQUIRE(allocator.allocate(4) == 0);
+  REQUIRE(allocator.allocate(4) == 4);
+  REQUIRE(allocator.allocate(4) == RangeAllocator::noOffset);
+  REQUIRE(allocator.allocate(2) == 8);
+  REQUIRE(allocator.getUsed() == 10);
+  REQUIRE_THROWS_AS(allocator.allocate(0), std::domain_error);
+}
+
+TEST_CASE("released ranges are reused and merged", "[RangeAllocator]") {
+
+  RangeAllocator allocator(12);
+
+  REQUIRE(allocator.allocate(4) == 0);
+  REQUIRE(allocator.allocate(4) == 4);
+  REQUIRE(allocator.allocate(4) == 8);
+
+  allocator.release(4, 4);
+  REQUIRE(allocator.getUsed() == 8);
+  REQUIRE(allocator.allocate(2) == 4);
+  REQUIRE(allocator.allocate(2) == 6);
+
+  allocator.release(0, 4);
+  allocator.release(4, 2);
+  allocator.release(6, 2);
+  REQUIRE(allocator.allocate(8) == 0);
+  REQUIRE(allocator.getUsed() == 12);
+}
+
+TEST_CASE("growing adds free space at the end", "[RangeAllocator]") {
+
+  RangeAllocator allocator;
+
+  REQUIRE(allocator.getCapacity() == 0);
+  REQUIRE(allocator.allocate(1) == RangeAllocator::noOffset);
+
+  allocator.grow(4);
+  REQUIRE(allocator.allocate(3) == 0);
+  REQUIRE(allocator.allocate(3) == RangeAllocator::noOffset);
+
+  allocator.grow(8);
+  REQUIRE(allocator.getCapacity() == 8);
+  REQUIRE(allocator.allocate(5) == 3);
+}
+
+TEST_CASE("only allocated ranges can be released", "[RangeAllocator]") {
+
+  RangeAllocator allocator(8);
+
+  REQUIRE(allocator.allocate(4) == 0);
+  REQUIRE_THROWS_AS(allocator.release(4, 2), std::invalid_argument);
+  REQUIRE_THROWS_AS(allocator.release(2, 4), std::invalid_argument);
+  REQUIRE_THROWS_AS(allocator.release(6, 4), std::out_of_range);
+}
@@ -0,0 +1,285 @@
+/**
+ * @file SamplerTest.cpp
+ * @brief Sampler tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-03-06
+ */
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+#include "src/main/math/Bezier.h"
+#include "src/main/math/Hermite3.h"
+#include "src/main/math/Hermite5.h"
+#include "src/main/renderer/CurvatureSampler.h"
+#include "src/main/renderer/MidpointSampler.h"
+#include "src/main/renderer/WangFlattener.h"
+
+using namespace iphito::math;
+using namespace iphito::renderer;
+
+namespace {
+
+double chordDeviation(Curve& curve, double a, double b) {
+  Eigen::Vector2d pa = curve.evaluateAt(a);
+  Eigen::Vector2d pb = curve.evaluateAt(b);
+  Eigen::Vector2d chord = (pb - pa).normalized();
+  double deviation = 0.0;
+
+  for (int i = 1; i < 8; i++) {
+    Eigen::Vector2d p = curve.evaluateAt(a + i * (b - a) / 8.0) - pa;
+    deviation =
+        std::max(deviation, std::abs(chord[0] * p[1] - chord[1] * p[0]));
+  }
+
+  return deviation;
+}
+
+} // namespace
+
+TEST_CASE("the curvature sampler covers the whole curve", "[Sampler]") {
+  Bezier b1({Eigen::Vector2d(-0.5, 0), Eigen::Vector2d(-0.7, 0.6),
+             Eigen::Vector2d(0.0, 0.9), Eigen::Vector2d(0.7, 0.6),
+             Eigen::Vector2d(0.5, 0)});
+  CurvatureSampler sampler;
+
+  std::vector<double> parameters;
+  std::vector<Eigen::Vector2d> points;
+  sampler.sample(b1, Eigen::Matrix4d::Identity(), 1e-3, 0, parameters,
+                 points);
+
+  REQUIRE(parameters.size() == points.size());
+  REQUIRE(parameters.front() == 0.0);
+  REQUIRE(parameters.back() == 1.0);
+
+  for (std::size_t i = 0; i < parameters.size(); i++) {
+    REQUIRE((points[i] - b1.evaluateAt(parameters[i])).norm() < 1e-12);
+    if (i > 0) {
+      REQUIRE(parameters[i - 1] < parameters[i]);
+    }
+  }
+}
+
+TEST_CASE("the curvature sampler respects its tolerance", "[Sampler]") {
+  Hermite3 h1(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(0.25, 0), Eigen::Vector2d(1, -2));
+
+  for (double tolerance : {1e-2, 1e-3, 1e-4}) {
+    CurvatureSampler sampler;
+    std::vector<double> parameters;
+    std::vector<Eigen::Vector2d> points;
+    sampler.sample(h1, Eigen::Matrix4d::Identity(), tolerance, 0, parameters,
+                   points);
+
+    for (std::size_t i = 1; i < parameters.size(); i++) {
+      REQUIRE(chordDeviation(h1, parameters[i - 1], parameters[i]) <
+              1.5 * tolerance);
+    }
+  }
+}
+
+TEST_CASE("the curvature sampler bounds the curvature between its probes",
+          "[Sampler]") {
+  /* Sharp turns between probes, which the curvature at the probes
+   * underestimates tenfold. */
+  Bezier b1({Eigen::Vector2d(0.488, 0.809), Eigen::Vector2d(0.999, -0.107),
+             Eigen::Vector2d(-0.080, 0.019), Eigen::Vector2d(0.797, -0.323),
+             Eigen::Vector2d(-0.544, 0.887), Eigen::Vector2d(0.923, 0.826),
+             Eigen::Vector2d(0.463, -0.773), Eigen::Vector2d(0.421, 0.841)});
+
+  for (double tolerance : {1e-2, 1e-3}) {
+    CurvatureSampler sampler;
+    std::vector<double> parameters;
+    std::vector<Eigen::Vector2d> points;
+    sampler.sample(b1, Eigen::Matrix4d::Identity(), tolerance, 0, parameters,
+                   points);
+
+    for (std::size_t i = 1; i < parameters.size(); i++) {
+      REQUIRE(chordDeviation(b1, parameters[i - 1], parameters[i]) <=
+              tolerance);
+    }
+  }
+}
+
+TEST_CASE("the curvature sampler is deterministic and follows the transform",
+          "[Sampler]") {
+  Hermite3 h1(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(0.25, 0), Eigen::Vector2d(1, -2));
+  CurvatureSampler sampler;
+
+  std::vector<double> first;
+  std::vector<double> second;
+  std::vector<Eigen::Vector2d> points;
+  sampler.sample(h1, Eigen::Matrix4d::Identity(), 1e-3, 0, first, points);
+  sampler.sample(h1, Eigen::Matrix4d::Identity(), 1e-3, 0, second, points);
+  REQUIRE(first == second);
+
+  Eigen::Matrix4d zoom = Eigen::Matrix4d::Identity();
+  zoom.topLeftCorner<2, 2>() *= 16.0;
+  std::vector<double> zoomed;
+  points.clear();
+  sampler.sample(h1, zoom, 1e-3, 0, zoomed, points);
+  REQUIRE(zoomed.size() > first.size());
+}
+
+TEST_CASE("Wang's formula bounds the chord deviation", "[Sampler]") {
+  Bezier b1({Eigen::Vector2d(-0.5, 0), Eigen::Vector2d(-0.7, 0.6),
+             Eigen::Vector2d(0.0, 0.9), Eigen::Vector2d(0.7, 0.6),
+             Eigen::Vector2d(0.5, 0)});
+  Hermite3 h1(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(0.25, 0), Eigen::Vector2d(1, -2));
+  Hermite5 h2(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(-4, 0), Eigen::Vector2d(0.25, 0),
+              Eigen::Vector2d(1, -2), Eigen::Vector2d(4, 0));
+  std::vector<Curve*> curves = {&b1, &h1, &h2};
+
+  for (Curve* curve : curves) {
+    for (double tolerance : {1e-2, 1e-3, 1e-4}) {
+      WangFlattener flattener;
+      std::vector<double> parameters;
+      std::vector<Eigen::Vector2d> points;
+      flattener.sample(*curve, Eigen::Matrix4d::Identity(), tolerance, 0,
+                       parameters, points);
+
+      REQUIRE(parameters.size() == static_cast<std::size_t>(
+              flattener.segmentCount(*curve, Eigen::Matrix4d::Identity(),
+                                     tolerance) + 1));
+      REQUIRE(parameters.front() == 0.0);
+      REQUIRE(parameters.back() == 1.0);
+
+      for (std::size_t i = 1; i < parameters.size(); i++) {
+        REQUIRE((points[i] - curve->evaluateAt(parameters[i])).norm() < 1e-12);
+        REQUIRE(chordDeviation(*curve, parameters[i - 1], parameters[i]) <=
+                tolerance);
+      }
+    }
+  }
+}
+
+TEST_CASE("Wang's formula scales with the transform", "[Sampler]") {
+  Bezier line({Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 1),
+               Eigen::Vector2d(2, 2)});
+  Bezier b1({Eigen::Vector2d(-0.5, 0), Eigen::Vector2d(0.0, 0.9),
+             Eigen::Vector2d(0.5, 0)});
+  WangFlattener flattener;
+
+  REQUIRE(flattener.segmentCount(line, Eigen::Matrix4d::Identity(), 1e-3) ==
+          1);
+
+  Eigen::Matrix4d zoom = Eigen::Matrix4d::Identity();
+  zoom.topLeftCorner<2, 2>() *= 16.0;
+  zoom(0, 3) = 100.0;
+  int segments = flattener.segmentCount(b1, Eigen::Matrix4d::Identity(), 1e-3);
+  int zoomed = flattener.segmentCount(b1, zoom, 1e-3);
+
+  REQUIRE(std::abs(zoomed - 4 * segments) <= 4);
+}
+
+TEST_CASE("the midpoint sampler respects its tolerance", "[Sampler]") {
+  Hermite3 h1(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(0.25, 0), Eigen::Vector2d(1, -2));
+  MidpointSampler sampler;
+
+  std::vector<double> parameters;
+  std::vector<Eigen::Vector2d> points;
+  sampler.sample(h1, Eigen::Matrix4d::Identity(), 1e-3, 0, parameters,
+                 points);
+
+  REQUIRE(parameters.size() == points.size());
+  REQUIRE(parameters.front() == 0.0);
+  REQUIRE(parameters.back() == 1.0);
+
+  for (std::size_t i = 1; i < parameters.size(); i++) {
+    REQUIRE(chordDeviation(h1, parameters[i - 1], parameters[i]) < 4e-3);
+  }
+}
+
+TEST_CASE("the midpoint sampler is reproducible", "[Sampler]") {
+  Bezier b1({Eigen::Vector2d(-0.5, 0), Eigen::Vector2d(-0.7, 0.6),
+             Eigen::Vector2d(0.0, 0.9), Eigen::Vector2d(0.7, 0.6),
+             Eigen::Vector2d(0.5, 0)});
+  MidpointSampler sampler;
+
+  std::vector<double> first;
+  std::vector<double> second;
+  std::vector<double> other;
+  std::vector<Eigen::Vector2d> points;
+  sampler.sample(b1, Eigen::Matrix4d::Identity(), 1e-4, 7, first, points);
+  sampler.sample(b1, Eigen::Matrix4d::Identity(), 1e-4, 7, second, points);
+  sampler.sample(b1, Eigen::Matrix4d::Identity(), 1e-4, 8, other, points);
+
+  REQUIRE(first == second);
+  REQUIRE(first != other);
+}
+
+TEST_CASE("samplers can be restricted to a parameter interval",
+          "[Sampler]") {
+  Hermite3 h1(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(0.25, 0), Eigen::Vector2d(1, -2));
+  CurvatureSampler curvature;
+  MidpointSampler midpoint;
+  WangFlattener wang;
+  const double tolerance = 1e-3;
+
+  for (Sampler* sampler :
+       std::vector<Sampler*>{&curvature, &midpoint, &wang}) {
+    std::vector<double> parameters;
+    std::vector<Eigen::Vector2d> points;
+    sampler->sample(h1, Eigen::Matrix4d::Identity(), tolerance, 3, 0.25, 0.5,
+                    parameters, points);
+
+    REQUIRE(parameters.size() == points.size());
+    REQUIRE(parameters.front() == 0.25);
+    REQUIRE(parameters.back() == 0.5);
+
+    for (std::size_t i = 1; i < parameters.size(); i++) {
+      REQUIRE(parameters[i - 1] < parameters[i]);
+      REQUIRE(chordDeviation(h1, parameters[i - 1], parameters[i]) <
+              1.5 * tolerance);
+    }
+  }
+}
+
+TEST_CASE("Wang's formula shares its segments between intervals",
+          "[Sampler]") {
+  Bezier b1({Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+             Eigen::Vector2d(3, -2), Eigen::Vector2d(4, 0)});
+  WangFlattener wang;
+
+  std::vector<double> whole;
+  std::vector<double> quarter;
+  std::vector<Eigen::Vector2d> points;
+  wang.sample(b1, Eigen::Matrix4d::Identity(), 1e-4, 0, whole, points);
+  wang.sample(b1, Eigen::Matrix4d::Identity(), 1e-4, 0, 0.5, 0.75, quarter,
+              points);
+
+  REQUIRE(quarter.size() - 1 <= (whole.size() - 1) / 4 + 1);
+  REQUIRE(quarter.size() - 1 >= (whole.size() - 1) / 4);
+}
+
+TEST_CASE("samplers terminate with a degenerate transform", "[Sampler]") {
+  Hermite3 h1(Eigen::Vector2d(0, 0), Eigen::Vector2d(1, 2),
+              Eigen::Vector2d(0.25, 0), Eigen::Vector2d(1, -2));
+  const Eigen::Matrix4d degenerate =
+      Eigen::Matrix4d::Constant(std::nan(""));
+  CurvatureSampler curvature;
+  MidpointSampler midpoint;
+  WangFlattener wang;
+
+  for (Sampler* sampler :
+       std::vector<Sampler*>{&curvature, &midpoint, &wang}) {
+    std::vector<double> parameters;
+    std::vector<Eigen::Vector2d> points;
+    sampler->sample(h1, degenerate, 0.25, 0, parameters, points);
+
+    REQUIRE(parameters.size() == points.size());
+    REQUIRE(parameters.size() >= 2);
+    REQUIRE(parameters.size() <= 4097);
+    REQUIRE(parameters.front() == 0.0);
+    REQUIRE(parameters.back() == 1.0);
+  }
+}
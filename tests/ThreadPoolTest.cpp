@@ -0,0 +1,63 @@
+/**
+ * @file ThreadPoolTest.cpp
+ * @brief ThreadPool tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-03-20
+ */
+#include "src/main/utils/ThreadPool.h"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <vector>
+
+using namespace iphito::utils;
+
+TEST_CASE("every iteration of a parallel for runs exactly once",
+          "[ThreadPool]") {
+
+  for (unsigned int workers : {0u, 1u, 3u, 8u}) {
+    ThreadPool pool(workers);
+    REQUIRE(pool.getWorkerCount() == workers);
+
+    for (std::size_t count : {0, 1, 7, 1000}) {
+      std::vector<std::atomic<int>> calls(count);
+
+      pool.parallelFor(count, [&calls](std::size_t i) { calls[i]++; });
+
+      for (auto& i : calls) {
+        REQUIRE(i.load() == 1);
+      }
+    }
+  }
+}
+
+TEST_CASE("a thread pool can run many parallel fors in a row",
+          "[ThreadPool]") {
+
+  ThreadPool pool(4);
+  std::atomic<long long> sum = 0;
+
+  for (int i = 0; i < 200; i++) {
+    pool.parallelFor(64, [&sum](std::size_t j) { sum += j; });
+  }
+
+  REQUIRE(sum.load() == 200 * (63 * 64 / 2));
+}
+
+TEST_CASE("exceptions thrown by a parallel for reach the caller",
+          "[ThreadPool]") {
+
+  ThreadPool pool(2);
+
+  REQUIRE_THROWS_AS(pool.parallelFor(100,
+                                     [](std::size_t i) {
+                                       if (i == 42)
+                                         throw std::runtime_error("42");
+                                     }),
+                    std::runtime_error);
+
+  std::atomic<int> calls = 0;
+  pool.parallelFor(10, [&calls](std::size_t i) { calls++; });
+  REQUIRE(calls.load() == 10);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file UtilsTest.cpp
+ * @brief Utils tests
+ * @author Samuel Gauthier
+ * @version 1.0
+ * @date 2021-02-13
+ */
+#include "src/main/utils/Utils.h"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+using namespace iphito::utils;
+
+TEST_CASE("factorials can be computed up to 19!", "[Utils]") {
+
+  unsigned long long expected = 1;
+
+  for (int i = 1; i <= 19; i++) {
+    expected *= i;
+    REQUIRE(Utils::factorial(i) == expected);
+  }
+
+  REQUIRE(Utils::factorial(0) == 1);
+  REQUIRE_THROWS_AS(Utils::factorial(-1), std::domain_error);
+  REQUIRE_THROWS_AS(Utils::factorial(20), std::domain_error);
+}
+
+TEST_CASE("binomial coefficients can be computed", "[Utils]") {
+
+  REQUIRE(Utils::binomial(0, 0) == 1.0);
+  REQUIRE(Utils::binomial(5, 2) == 10.0);
+  REQUIRE(Utils::binomial(10, 5) == 252.0);
+  REQUIRE(Utils::binomial(30, 15) == 155117520.0);
+  REQUIRE(Utils::binomial(60, 30) == 118264581564861424.0);
+  REQUIRE(Utils::nearlyEqual(Utils::binomial(1000, 500), 2.702882409454366e299,
+                             1e-12));
+
+  REQUIRE_THROWS_AS(Utils::binomial(3, 4), std::domain_error);
+  REQUIRE_THROWS_AS(Utils::binomial(3, -1), std::domain_error);
+  REQUIRE_THROWS_AS(Utils::binomial(2000, 1000), std::overflow_error);
+}
+
+TEST_CASE("counter-based hashes are reproducible and uniform", "[Utils]") {
+
+  REQUIRE(Utils::hash(1, 2) == Utils::hash(1, 2));
+  REQUIRE(Utils::hash(1, 2) != Utils::hash(2, 1));
+
+  std::set<unsigned long long> hashes;
+  double sum = 0.0;
+  const int count = 10000;
+
+  for (int i = 0; i < count; i++) {
+    hashes.insert(Utils::hash(42, i));
+
+    double u = Utils::uniform(42, i);
+    REQUIRE(u >= 0.0);
+    REQUIRE(u < 1.0);
+    sum += u;
+  }
+
+  REQUIRE(hashes.size() == count);
+  REQUIRE(std::abs(sum / count - 0.5) < 0.01);
+}
+
+TEST_CASE("files are read whole and byte for byte", "[Utils]") {
+
+  std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "iphito_read_file_test";
+  const std::string content("first line\nsecond\0line\n", 23);
+
+  {
+    std::ofstream stream(path, std::ios::out | std::ios::binary);
+    stream << content;
+  }
+
+  REQUIRE(Utils::readFile(path.string()) == content);
+
+  std::filesystem::remove(path);
+  REQUIRE_THROWS_AS(Utils::readFile(path.string()), std::invalid_argument);
+}